@@ -0,0 +1,58 @@
+#include "allocation_counter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+std::atomic<std::size_t> count{0};
+
+void* counted(const std::size_t size)
+{
+    count.fetch_add(1, std::memory_order_relaxed);
+
+    if (void* const memory{std::malloc(size == 0 ? 1 : size)})
+    {
+        return memory;
+    }
+
+    throw std::bad_alloc{};
+}
+
+} // namespace
+
+std::size_t parser::idl::bench::allocations() noexcept
+{
+    return count.load(std::memory_order_relaxed);
+}
+
+void* operator new(const std::size_t size)
+{
+    return counted(size);
+}
+
+void* operator new[](const std::size_t size)
+{
+    return counted(size);
+}
+
+void operator delete(void* const memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* const memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* const memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* const memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
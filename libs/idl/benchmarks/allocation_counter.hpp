@@ -0,0 +1,18 @@
+#ifndef PARSER_LIBS_IDL_BENCHMARKS_ALLOCATION_COUNTER_HPP
+#define PARSER_LIBS_IDL_BENCHMARKS_ALLOCATION_COUNTER_HPP
+
+#include <cstddef>
+
+namespace parser::idl::bench
+{
+/**
+ * @brief Number of calls to the global `operator new` made by this process so far.
+ *
+ * Counted by the replacement allocation functions in allocation_counter.cpp; take the difference of two readings
+ * to count the allocations made by a piece of code.
+ */
+std::size_t allocations() noexcept;
+
+} // namespace parser::idl::bench
+
+#endif // PARSER_LIBS_IDL_BENCHMARKS_ALLOCATION_COUNTER_HPP
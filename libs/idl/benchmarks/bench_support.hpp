@@ -0,0 +1,115 @@
+#ifndef PARSER_LIBS_IDL_BENCHMARKS_BENCH_SUPPORT_HPP
+#define PARSER_LIBS_IDL_BENCHMARKS_BENCH_SUPPORT_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include "parser/idl/lexer_factory.hpp"
+
+namespace parser::idl::bench
+{
+/**
+ * @brief Build the library's IDL lexer.
+ */
+inline lexer::core::Lexer build_lexer(const Keyword_mode mode = Keyword_mode::Perfect_hash)
+{
+    return Lexer_factory::build(mode);
+}
+
+/**
+ * @brief Generate a synthetic IDL translation unit of roughly the requested size.
+ *
+ * @param bytes     Approximate size of the generated text.
+ * @param line_end  Line terminator to use ("\n" or "\r\n").
+ */
+inline std::string make_corpus(const std::size_t bytes, const std::string_view line_end = "\n")
+{
+    std::string corpus;
+
+    corpus.reserve(bytes + 512);
+
+    for (std::size_t index = 0; corpus.size() < bytes; ++index)
+    {
+        const auto id{std::to_string(index)};
+
+        corpus.append("// Generated module ").append(id).append(line_end);
+        corpus.append("module m").append(id).append(" {").append(line_end);
+        corpus.append("    struct s").append(id).append(" { long a; double b; string c; };").append(line_end);
+        corpus.append("    const long k").append(id).append(" = 1234;").append(line_end);
+        corpus.append("};").append(line_end);
+    }
+
+    return corpus;
+}
+
+/**
+ * @brief Directory of this run's corpus files, created in the temporary directory and removed with its contents at
+ * exit, so concurrent runs do not overwrite each other's files and none are left behind.
+ */
+class Corpus_directory
+{
+public:
+    Corpus_directory()
+    {
+        std::random_device random;
+
+        do
+        {
+            path_ = std::filesystem::temp_directory_path() / ("parser_idl_bench_" + std::to_string(random()));
+        } while (!std::filesystem::create_directory(path_));
+    }
+
+    Corpus_directory(const Corpus_directory&) = delete;
+
+    Corpus_directory& operator=(const Corpus_directory&) = delete;
+
+    ~Corpus_directory()
+    {
+        std::error_code error;
+
+        std::filesystem::remove_all(path_, error);
+    }
+
+    [[nodiscard]] const std::filesystem::path& path() const noexcept
+    {
+        return path_;
+    }
+
+private:
+    std::filesystem::path path_;
+};
+
+/**
+ * @brief Write the given contents to a file in this run's corpus directory and return its path.
+ *
+ * @throws std::runtime_error If the file cannot be written in full.
+ */
+inline std::filesystem::path write_corpus(const std::string_view name, const std::string_view contents)
+{
+    static const Corpus_directory directory;
+
+    const auto path{directory.path() / name};
+
+    std::ofstream out{path, std::ios::binary};
+
+    out.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+
+    out.close();
+
+    if (!out)
+    {
+        throw std::runtime_error("cannot write benchmark corpus: " + path.string());
+    }
+
+    return path;
+}
+
+} // namespace parser::idl::bench
+
+#endif // PARSER_LIBS_IDL_BENCHMARKS_BENCH_SUPPORT_HPP
@@ -0,0 +1,246 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <string>
+
+#include "allocation_counter.hpp"
+#include "bench_support.hpp"
+#include "corpus_generator.hpp"
+#include "parser/idl/arena.hpp"
+#include "parser/idl/parser.hpp"
+#include "parser/idl/token_reader.hpp"
+
+using namespace parser::idl;
+
+namespace
+{
+constexpr std::size_t corpus_bytes{4UL << 20};
+
+constexpr std::size_t shape_count{5};
+
+bench::Corpus_options options(const benchmark::State& state, const bool crlf = false)
+{
+    return {.shape = static_cast<bench::Corpus_shape>(state.range(0)),
+            .bytes = corpus_bytes,
+            .crlf = crlf,
+            .seed = 1,
+            .depth = 32,
+            .width = 256,
+            .string_length = 4096};
+}
+
+const std::string& corpus(const benchmark::State& state)
+{
+    static std::array<std::string, shape_count> corpora;
+
+    auto& corpus{corpora[static_cast<std::size_t>(state.range(0))]};
+
+    if (corpus.empty())
+    {
+        corpus = bench::generate_corpus(options(state));
+    }
+
+    return corpus;
+}
+
+const std::filesystem::path& corpus_path(const benchmark::State& state, const bool crlf)
+{
+    static std::array<std::array<std::filesystem::path, 2>, shape_count> paths;
+
+    auto& path{paths[static_cast<std::size_t>(state.range(0))][crlf ? 1 : 0]};
+
+    if (path.empty())
+    {
+        const auto name{"parser_idl_bench_" + std::string{bench::shape_name(options(state).shape)} +
+                        (crlf ? "_crlf.idl" : "_lf.idl")};
+
+        path = bench::write_corpus(name, bench::generate_corpus(options(state, crlf)));
+    }
+
+    return path;
+}
+
+/**
+ * Report throughput in bytes and tokens per second and heap allocations per token.
+ */
+void report(benchmark::State& state, const std::size_t bytes, const std::size_t tokens, const std::size_t allocations)
+{
+    state.SetLabel(std::string{bench::shape_name(static_cast<bench::Corpus_shape>(state.range(0)))});
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+    state.counters["tokens"] = benchmark::Counter(static_cast<double>(tokens), benchmark::Counter::kIsRate);
+    state.counters["allocations_per_token"] =
+            tokens == 0 ? 0.0 : static_cast<double>(allocations) / static_cast<double>(tokens);
+}
+
+void BM_Corpus_next(benchmark::State& state)
+{
+    Token_reader reader{bench::build_lexer(), corpus(state), static_cast<Location_mode>(state.range(1))};
+
+    std::size_t tokens{0};
+
+    std::size_t allocations{0};
+
+    for (auto _ : state)
+    {
+        reader.reset();
+
+        const auto before{bench::allocations()};
+
+        for (auto expected{reader.next()}; expected && *expected; expected = reader.next())
+        {
+            benchmark::DoNotOptimize(reader.location().column());
+
+            ++tokens;
+        }
+
+        allocations += bench::allocations() - before;
+    }
+
+    report(state, corpus(state).size(), tokens, allocations);
+}
+
+/**
+ * Every token is peeked at every lookahead depth before it is consumed, as a parser deciding between productions
+ * would; all but the first peek of each token must be served from the lookahead ring.
+ */
+void BM_Corpus_peek(benchmark::State& state)
+{
+    Token_reader reader{bench::build_lexer(), corpus(state)};
+
+    std::size_t tokens{0};
+
+    std::size_t allocations{0};
+
+    for (auto _ : state)
+    {
+        reader.reset();
+
+        const auto before{bench::allocations()};
+
+        for (;;)
+        {
+            for (std::size_t n = Token_lookahead::capacity; n-- > 0;)
+            {
+                benchmark::DoNotOptimize(reader.peek(n));
+            }
+
+            if (const auto expected{reader.next()}; !expected || !*expected)
+            {
+                break;
+            }
+
+            ++tokens;
+        }
+
+        allocations += bench::allocations() - before;
+    }
+
+    report(state, corpus(state).size(), tokens, allocations);
+}
+
+/**
+ * Load the corpus from a file, normalizing line ends, and tokenize it.
+ */
+void BM_Corpus_load(benchmark::State& state)
+{
+    const auto& path{corpus_path(state, state.range(1) != 0)};
+
+    Token_reader reader{bench::build_lexer(), Location_mode::Lazy};
+
+    std::size_t tokens{0};
+
+    std::size_t allocations{0};
+
+    for (auto _ : state)
+    {
+        const auto before{bench::allocations()};
+
+        reader.load(path);
+
+        for (auto expected{reader.next()}; expected && *expected; expected = reader.next())
+        {
+            ++tokens;
+        }
+
+        allocations += bench::allocations() - before;
+    }
+
+    report(state, std::filesystem::file_size(path), tokens, allocations);
+}
+
+void BM_Corpus_parse(benchmark::State& state)
+{
+    Token_reader reader{bench::build_lexer(), corpus(state)};
+
+    Arena arena;
+
+    std::size_t tokens{0};
+
+    std::size_t allocations{0};
+
+    for (auto _ : state)
+    {
+        reader.reset();
+
+        arena.reset();
+
+        const auto before{bench::allocations()};
+
+        Parser parser{reader, arena};
+
+        const auto result{parser.parse()};
+
+        allocations += bench::allocations() - before;
+
+        if (!result)
+        {
+            state.SkipWithError(result.error().message.c_str());
+
+            return;
+        }
+
+        benchmark::DoNotOptimize(result.value());
+    }
+
+    // Token count of one pass, for the per-token figures.
+    reader.reset();
+
+    for (auto expected{reader.next()}; expected && *expected; expected = reader.next())
+    {
+        ++tokens;
+    }
+
+    report(state, corpus(state).size(), tokens * state.iterations(), allocations);
+}
+
+void shapes(benchmark::internal::Benchmark* target)
+{
+    target->ArgName("shape")->DenseRange(0, shape_count - 1);
+}
+
+/**
+ * Every shape, with a second argument switching a feature off and on.
+ */
+void shapes_by(benchmark::internal::Benchmark* target, const char* const name)
+{
+    target->ArgNames({"shape", name})->ArgsProduct({benchmark::CreateDenseRange(0, shape_count - 1, 1), {0, 1}});
+}
+
+void shapes_by_location_mode(benchmark::internal::Benchmark* target)
+{
+    shapes_by(target, "lazy");
+}
+
+void shapes_by_line_end(benchmark::internal::Benchmark* target)
+{
+    shapes_by(target, "crlf");
+}
+
+} // namespace
+
+BENCHMARK(BM_Corpus_next)->Apply(shapes_by_location_mode)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Corpus_peek)->Apply(shapes)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Corpus_load)->Apply(shapes_by_line_end)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Corpus_parse)->Apply(shapes)->Unit(benchmark::kMillisecond);
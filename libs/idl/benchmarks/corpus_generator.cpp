@@ -0,0 +1,233 @@
+#include "corpus_generator.hpp"
+
+#include <array>
+#include <random>
+#include <string>
+#include <utility>
+
+namespace parser::idl::bench
+{
+namespace
+{
+constexpr std::array<std::string_view, 14> member_types{
+        "short",      "long",    "long long", "unsigned short", "unsigned long", "float",         "double",
+        "boolean",    "char",    "octet",     "string",         "wstring",       "sequence<long>", "string<32>"};
+
+/**
+ * Appends indented lines with the configured terminator and draws the pseudo-random choices.
+ */
+class Writer
+{
+public:
+    explicit Writer(const Corpus_options& options) : options_{options}, random_{options.seed}
+    {
+        text_.reserve(options.bytes + 4096);
+    }
+
+    [[nodiscard]] bool full() const noexcept
+    {
+        return text_.size() >= options_.bytes;
+    }
+
+    void line(const std::string_view content)
+    {
+        text_.append(4 * indent_, ' ').append(content).append(options_.crlf ? "\r\n" : "\n");
+    }
+
+    void open(const std::string_view content)
+    {
+        line(content);
+
+        ++indent_;
+    }
+
+    void close()
+    {
+        --indent_;
+
+        line("};");
+    }
+
+    [[nodiscard]] std::string name(const std::string_view prefix)
+    {
+        return std::string{prefix}.append(std::to_string(next_++));
+    }
+
+    [[nodiscard]] std::string_view type()
+    {
+        return member_types[std::uniform_int_distribution<std::size_t>{0, member_types.size() - 1}(random_)];
+    }
+
+    [[nodiscard]] std::string literal(const std::size_t length)
+    {
+        std::uniform_int_distribution<int> character{' ', '~'};
+
+        std::string literal{"\""};
+
+        while (literal.size() <= length)
+        {
+            // Quotes and backslashes would end or escape the literal, and a slash could close the block comment.
+            if (const auto c{static_cast<char>(character(random_))}; c != '"' && c != '\\' && c != '/')
+            {
+                literal.push_back(c);
+            }
+        }
+
+        return literal.append("\"");
+    }
+
+    [[nodiscard]] std::string take() noexcept
+    {
+        return std::move(text_);
+    }
+
+private:
+    const Corpus_options& options_;
+
+    std::mt19937 random_;
+
+    std::string text_;
+
+    std::size_t indent_{0};
+
+    std::size_t next_{0};
+};
+
+void structure(Writer& writer, const std::size_t members)
+{
+    writer.open(writer.name("struct S") + " {");
+
+    for (std::size_t member = 0; member < members; ++member)
+    {
+        writer.line(std::string{writer.type()}.append(" ").append(writer.name("m")).append(";"));
+    }
+
+    writer.close();
+}
+
+void mixed(Writer& writer)
+{
+    writer.open(writer.name("module M") + " {");
+
+    structure(writer, 4);
+
+    writer.line("enum " + writer.name("E") + " { red, green, blue };");
+
+    writer.line("typedef sequence<" + std::string{writer.type()} + ", 16> " + writer.name("T") + ";");
+
+    writer.line("const long " + writer.name("K") + " = 2 * (3 + 4);");
+
+    writer.open(writer.name("interface I") + " {");
+
+    writer.line("attribute " + std::string{writer.type()} + " " + writer.name("a") + ";");
+
+    writer.line("void " + writer.name("f") + "(in long x, out string y, inout double z);");
+
+    writer.close();
+
+    writer.close();
+}
+
+void nested(Writer& writer, const std::size_t depth)
+{
+    writer.open(writer.name("module N") + " {");
+
+    writer.line("const long " + writer.name("K") + " = " + std::to_string(depth) + ";");
+
+    if (depth > 1)
+    {
+        nested(writer, depth - 1);
+    }
+
+    structure(writer, 2);
+
+    writer.close();
+}
+
+void commented(Writer& writer)
+{
+    writer.line("// " + writer.name("Section "));
+
+    writer.line("// Every definition below is documented with a few lines of prose that the lexer");
+
+    writer.line("// has to skip as trivia before it reaches the next token of interest.");
+
+    writer.open(writer.name("module C") + " { // trailing comment");
+
+    for (int definition = 0; definition < 4; ++definition)
+    {
+        writer.line("// " + writer.name("Constant "));
+
+        writer.line("// Value chosen arbitrarily.");
+
+        writer.line("const long " + writer.name("K") + " = 42; // the answer");
+    }
+
+    writer.close();
+}
+
+void strings(Writer& writer, const std::size_t length)
+{
+    writer.open(writer.name("module L") + " {");
+
+    writer.line("const string " + writer.name("S") + " = " + writer.literal(length) + ";");
+
+    writer.line("const wstring " + writer.name("W") + " = " + writer.literal(length / 4) + ";");
+
+    writer.close();
+}
+
+} // namespace
+
+std::string generate_corpus(const Corpus_options& options)
+{
+    Writer writer{options};
+
+    writer.line("/* Generated corpus: shape " + std::string{shape_name(options.shape)} + ", seed " +
+                std::to_string(options.seed) + " */");
+
+    while (!writer.full())
+    {
+        switch (options.shape)
+        {
+        case Corpus_shape::Mixed:
+            mixed(writer);
+            break;
+        case Corpus_shape::Deep_nesting:
+            nested(writer, options.depth);
+            break;
+        case Corpus_shape::Wide_structs:
+            structure(writer, options.width);
+            break;
+        case Corpus_shape::Comment_heavy:
+            commented(writer);
+            break;
+        case Corpus_shape::Long_strings:
+            strings(writer, options.string_length);
+            break;
+        }
+    }
+
+    return writer.take();
+}
+
+std::string_view shape_name(const Corpus_shape shape) noexcept
+{
+    switch (shape)
+    {
+    case Corpus_shape::Mixed:
+        return "mixed";
+    case Corpus_shape::Deep_nesting:
+        return "deep_nesting";
+    case Corpus_shape::Wide_structs:
+        return "wide_structs";
+    case Corpus_shape::Comment_heavy:
+        return "comment_heavy";
+    case Corpus_shape::Long_strings:
+        return "long_strings";
+    }
+
+    return {};
+}
+
+} // namespace parser::idl::bench
@@ -0,0 +1,86 @@
+#ifndef PARSER_LIBS_IDL_BENCHMARKS_CORPUS_GENERATOR_HPP
+#define PARSER_LIBS_IDL_BENCHMARKS_CORPUS_GENERATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace parser::idl::bench
+{
+/**
+ * @brief Dominant structure of a generated corpus.
+ */
+enum class Corpus_shape
+{
+    /**
+     * @brief A mix of modules, structs, enums, typedefs, constants and interfaces.
+     */
+    Mixed,
+
+    /**
+     * @brief Modules nested `depth` levels deep, with a few definitions at every level.
+     */
+    Deep_nesting,
+
+    /**
+     * @brief Structs of `width` members each.
+     */
+    Wide_structs,
+
+    /**
+     * @brief Several comment lines and a trailing comment for every definition.
+     */
+    Comment_heavy,
+
+    /**
+     * @brief String constants of `string_length` characters.
+     */
+    Long_strings
+};
+
+/**
+ * @brief Size and shape of a generated corpus.
+ */
+struct Corpus_options
+{
+    Corpus_shape shape{Corpus_shape::Mixed};
+
+    /**
+     * @brief Approximate size of the generated text; the last top-level module is always completed.
+     */
+    std::size_t bytes{1UL << 20};
+
+    /**
+     * @brief Terminate lines with "\r\n" instead of "\n".
+     */
+    bool crlf{false};
+
+    /**
+     * @brief Seed of the pseudo-random choices; equal options always produce identical text.
+     */
+    std::uint32_t seed{1};
+
+    std::size_t depth{32};
+
+    std::size_t width{256};
+
+    std::size_t string_length{4096};
+};
+
+/**
+ * @brief Generate a syntactically valid IDL translation unit.
+ *
+ * Only one block comment is emitted, at the top of the file, since the IDL lexer matches block comments greedily
+ * up to the last terminator.
+ */
+std::string generate_corpus(const Corpus_options& options);
+
+/**
+ * @brief Short lower-case name of a shape, for benchmark labels and file names.
+ */
+std::string_view shape_name(Corpus_shape shape) noexcept;
+
+} // namespace parser::idl::bench
+
+#endif // PARSER_LIBS_IDL_BENCHMARKS_CORPUS_GENERATOR_HPP
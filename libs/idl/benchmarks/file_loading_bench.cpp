@@ -0,0 +1,210 @@
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "bench_support.hpp"
+#include "parser/idl/file_prefetcher.hpp"
+#include "parser/idl/token_reader.hpp"
+
+using namespace parser::idl;
+
+namespace
+{
+constexpr std::size_t corpus_bytes{64UL << 20};
+
+const std::filesystem::path& corpus_path(const bool crlf)
+{
+    static const std::filesystem::path lf{bench::write_corpus("parser_idl_bench_lf.idl", bench::make_corpus(corpus_bytes))};
+
+    static const std::filesystem::path cr_lf{
+            bench::write_corpus("parser_idl_bench_crlf.idl", bench::make_corpus(corpus_bytes, "\r\n"))};
+
+    return crlf ? cr_lf : lf;
+}
+
+/**
+ * Reference: the previous loading path (istreambuf_iterator copy followed by a normalizing copy).
+ */
+void BM_Load_buffered(benchmark::State& state)
+{
+    const auto& path{corpus_path(state.range(0) != 0)};
+
+    Token_reader reader{bench::build_lexer()};
+
+    for (auto _ : state)
+    {
+        std::ifstream stream{path, std::ios::binary};
+
+        const std::string contents{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+
+        reader.load(contents);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * std::filesystem::file_size(path)));
+}
+
+/**
+ * The same read, with the buffer handed over: LF input reaches the tokenizer without another copy.
+ */
+void BM_Load_adopted(benchmark::State& state)
+{
+    const auto& path{corpus_path(state.range(0) != 0)};
+
+    Token_reader reader{bench::build_lexer()};
+
+    for (auto _ : state)
+    {
+        std::ifstream stream{path, std::ios::binary};
+
+        std::string contents{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+
+        reader.load(std::move(contents));
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * std::filesystem::file_size(path)));
+}
+
+/**
+ * Text already held by the caller, borrowed for the call: one normalizing copy and nothing else.
+ */
+void BM_Load_borrowed(benchmark::State& state)
+{
+    const auto& path{corpus_path(state.range(0) != 0)};
+
+    std::ifstream stream{path, std::ios::binary};
+
+    const std::string contents{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+
+    Token_reader reader{bench::build_lexer()};
+
+    for (auto _ : state)
+    {
+        reader.load(std::string_view{contents});
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * contents.size()));
+}
+
+void BM_Load_mapped(benchmark::State& state)
+{
+    const auto& path{corpus_path(state.range(0) != 0)};
+
+    Token_reader reader{bench::build_lexer()};
+
+    for (auto _ : state)
+    {
+        reader.load(path);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * std::filesystem::file_size(path)));
+}
+
+/**
+ * Small files on a slow file system: every load waits `latency` before reading, like a cold network mount. Timed
+ * in wall-clock time, since hiding that wait is the point.
+ */
+constexpr std::size_t pipeline_files{16};
+
+constexpr std::size_t pipeline_file_bytes{8UL << 10};
+
+constexpr std::chrono::milliseconds latency{2};
+
+const std::vector<std::filesystem::path>& pipeline_paths()
+{
+    static const std::vector<std::filesystem::path> paths{[] {
+        std::vector<std::filesystem::path> result;
+
+        const auto corpus{bench::make_corpus(pipeline_file_bytes)};
+
+        for (std::size_t index{0}; index < pipeline_files; ++index)
+        {
+            std::string name{"parser_idl_bench_pipeline_"};
+
+            name.append(std::to_string(index)).append(".idl");
+
+            result.push_back(bench::write_corpus(name, corpus));
+        }
+
+        return result;
+    }()};
+
+    return paths;
+}
+
+File_prefetcher::Result_t slow_load(const std::filesystem::path& file)
+{
+    std::this_thread::sleep_for(latency);
+
+    return File_prefetcher::load(file);
+}
+
+std::size_t drain(Token_reader& reader)
+{
+    std::size_t tokens{0};
+
+    for (auto expected{reader.next()}; expected && *expected; expected = reader.next())
+    {
+        ++tokens;
+    }
+
+    return tokens;
+}
+
+/**
+ * Reference: each file is loaded on the tokenizing thread, so every latency stalls it.
+ */
+void BM_Pipeline_sequential(benchmark::State& state)
+{
+    Token_reader reader{bench::build_lexer()};
+
+    for (auto _ : state)
+    {
+        for (const auto& path : pipeline_paths())
+        {
+            reader.load(std::move(*slow_load(path)));
+
+            benchmark::DoNotOptimize(drain(reader));
+        }
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * pipeline_files * pipeline_file_bytes));
+}
+
+/**
+ * The same files loaded by a `File_prefetcher` reading `depth` files ahead while the reader tokenizes.
+ */
+void BM_Pipeline_prefetched(benchmark::State& state)
+{
+    Token_reader reader{bench::build_lexer()};
+
+    for (auto _ : state)
+    {
+        File_prefetcher files{pipeline_paths(), slow_load, static_cast<std::size_t>(state.range(0))};
+
+        while (auto text{files.next()})
+        {
+            reader.load(std::move(**text));
+
+            benchmark::DoNotOptimize(drain(reader));
+        }
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * pipeline_files * pipeline_file_bytes));
+}
+
+} // namespace
+
+BENCHMARK(BM_Load_buffered)->ArgName("crlf")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Load_adopted)->ArgName("crlf")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Load_borrowed)->ArgName("crlf")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Load_mapped)->ArgName("crlf")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Pipeline_sequential)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Pipeline_prefetched)->ArgName("depth")->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "bench_support.hpp"
+#include "parser/idl/token_reader.hpp"
+
+using namespace parser::idl;
+
+namespace
+{
+constexpr std::size_t corpus_bytes{1UL << 20};
+
+const std::string& corpus()
+{
+    static const std::string corpus{bench::make_corpus(corpus_bytes)};
+
+    return corpus;
+}
+
+/**
+ * Lexer construction time, a proxy for DFA size (the lexer does not expose its state count).
+ */
+void BM_Build_lexer(benchmark::State& state)
+{
+    const auto mode{static_cast<Keyword_mode>(state.range(0))};
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(Lexer_factory::build(mode));
+    }
+}
+
+void BM_Tokenize_keywords(benchmark::State& state)
+{
+    const auto mode{static_cast<Keyword_mode>(state.range(0))};
+
+    Token_reader reader{Lexer_factory::build(mode), corpus()};
+
+    std::size_t tokens{0};
+
+    for (auto _ : state)
+    {
+        tokens += reader.tape()->size();
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * corpus().size()));
+    state.counters["tokens"] = benchmark::Counter(static_cast<double>(tokens), benchmark::Counter::kIsRate);
+}
+
+} // namespace
+
+BENCHMARK(BM_Build_lexer)->ArgName("perfect_hash")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Tokenize_keywords)->ArgName("perfect_hash")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,176 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "bench_support.hpp"
+#include "parser/idl/line_index.hpp"
+#include "parser/idl/source_manager.hpp"
+#include "parser/idl/token_reader.hpp"
+#include "parser/idl/utf8.hpp"
+
+using namespace parser::idl;
+
+namespace
+{
+constexpr std::size_t corpus_bytes{1UL << 20};
+
+const std::string& corpus()
+{
+    static const std::string corpus{bench::make_corpus(corpus_bytes)};
+
+    return corpus;
+}
+
+void BM_Next_with_locations(benchmark::State& state)
+{
+    const auto mode{static_cast<Location_mode>(state.range(0))};
+
+    Token_reader reader{bench::build_lexer(), corpus(), mode};
+
+    std::size_t tokens{0};
+
+    for (auto _ : state)
+    {
+        reader.reset();
+
+        for (auto expected{reader.next()}; expected && *expected; expected = reader.next())
+        {
+            ++tokens;
+        }
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * corpus().size()));
+    state.counters["tokens"] = benchmark::Counter(static_cast<double>(tokens), benchmark::Counter::kIsRate);
+}
+
+/**
+ * Eager locations counted in each column unit; the corpus is ASCII, so this is the cost of the unit itself.
+ */
+void BM_Next_with_column_unit(benchmark::State& state)
+{
+    Token_reader reader{bench::build_lexer()};
+
+    reader.set_column_unit(static_cast<Column_unit>(state.range(0)));
+
+    reader.load(corpus());
+
+    for (auto _ : state)
+    {
+        reader.reset();
+
+        for (auto expected{reader.next()}; expected && *expected; expected = reader.next())
+        {
+            benchmark::DoNotOptimize(reader.location().column());
+        }
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * corpus().size()));
+}
+
+/**
+ * Code points of a mostly non-ASCII text per instruction set.
+ */
+void BM_Utf8_code_points(benchmark::State& state)
+{
+    const auto isa{static_cast<Isa>(state.range(0))};
+
+    if (!isa_supported(isa))
+    {
+        state.SkipWithError("instruction set not supported");
+
+        return;
+    }
+
+    std::string text;
+
+    while (text.size() < corpus_bytes)
+    {
+        text += "// \xC3\xA9t\xC3\xA9 \xE2\x82\xAC \xF0\x9D\x84\x9E\n";
+    }
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(Utf8::code_points(text, isa));
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+
+void BM_Line_index_build(benchmark::State& state)
+{
+    const auto isa{static_cast<Isa>(state.range(0))};
+
+    if (!isa_supported(isa))
+    {
+        state.SkipWithError("instruction set not supported");
+
+        return;
+    }
+
+    Line_index index;
+
+    for (auto _ : state)
+    {
+        index.build(corpus(), isa);
+
+        benchmark::DoNotOptimize(index.lines());
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * corpus().size()));
+}
+
+/**
+ * Keeping the location of every token: full `Token_location` copies versus 4-byte `Source_location`s decoded
+ * through a `Source_manager`. Reports the memory kept per token.
+ */
+void BM_Keep_token_locations(benchmark::State& state)
+{
+    const auto compact{state.range(0) != 0};
+
+    Token_reader reader{bench::build_lexer(), corpus()};
+
+    Source_manager manager;
+
+    const auto file{manager.add("corpus.idl", corpus())};
+
+    std::vector<Token_location> full;
+
+    std::vector<Source_location> locations;
+
+    for (auto _ : state)
+    {
+        reader.reset();
+
+        full.clear();
+
+        locations.clear();
+
+        for (auto expected{reader.next()}; expected && *expected; expected = reader.next())
+        {
+            if (compact)
+            {
+                locations.push_back(manager.location(file, reader.location().offset()));
+            }
+            else
+            {
+                full.push_back(reader.location());
+            }
+        }
+    }
+
+    const auto tokens{compact ? locations.size() : full.size()};
+
+    const auto bytes{compact ? locations.size() * sizeof(Source_location) : full.size() * sizeof(Token_location)};
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * corpus().size()));
+    state.counters["bytes_per_token"] = static_cast<double>(bytes) / static_cast<double>(tokens);
+}
+
+} // namespace
+
+BENCHMARK(BM_Next_with_locations)->ArgName("lazy")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Next_with_column_unit)->ArgName("unit")->Arg(0)->Arg(1)->Arg(2)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Keep_token_locations)->ArgName("compact")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Utf8_code_points)->ArgName("isa")->Arg(0)->Arg(1)->Arg(2);
+BENCHMARK(BM_Line_index_build)->ArgName("isa")->Arg(0)->Arg(1)->Arg(2);
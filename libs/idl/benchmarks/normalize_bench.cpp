@@ -0,0 +1,123 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "bench_support.hpp"
+#include "parser/idl/newline_normalizer.hpp"
+
+using namespace parser::idl;
+
+namespace
+{
+constexpr std::size_t corpus_bytes{16UL << 20};
+
+const std::string& corpus(const bool crlf)
+{
+    static const std::string lf{bench::make_corpus(corpus_bytes)};
+
+    static const std::string cr_lf{bench::make_corpus(corpus_bytes, "\r\n")};
+
+    return crlf ? cr_lf : lf;
+}
+
+/**
+ * Reference: the previous byte-at-a-time normalizer.
+ */
+std::string push_back_normalize(const std::string& input)
+{
+    std::string output;
+
+    output.reserve(input.size());
+
+    for (auto iterator = input.cbegin(); iterator != input.cend();)
+    {
+        if (const char c = *iterator++; c == '\r')
+        {
+            if (iterator != input.cend() && *iterator == '\n')
+            {
+                ++iterator;
+            }
+
+            output.push_back('\n');
+        }
+        else
+        {
+            output.push_back(c);
+        }
+    }
+
+    return output;
+}
+
+void BM_Normalize_push_back(benchmark::State& state)
+{
+    const auto& input{corpus(state.range(0) != 0)};
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(push_back_normalize(input));
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * input.size()));
+}
+
+void BM_Normalize_copy(benchmark::State& state)
+{
+    const auto& input{corpus(state.range(0) != 0)};
+
+    const auto isa{static_cast<Isa>(state.range(1))};
+
+    if (!isa_supported(isa))
+    {
+        state.SkipWithError("instruction set not supported");
+
+        return;
+    }
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(Newline_normalizer::normalize(std::string_view{input}, isa));
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * input.size()));
+}
+
+void BM_Normalize_in_place(benchmark::State& state)
+{
+    const auto& input{corpus(state.range(0) != 0)};
+
+    const auto isa{static_cast<Isa>(state.range(1))};
+
+    if (!isa_supported(isa))
+    {
+        state.SkipWithError("instruction set not supported");
+
+        return;
+    }
+
+    std::string buffer;
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+
+        buffer = input;
+
+        state.ResumeTiming();
+
+        Newline_normalizer::normalize(buffer, isa);
+
+        benchmark::DoNotOptimize(buffer.data());
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * input.size()));
+}
+
+} // namespace
+
+BENCHMARK(BM_Normalize_push_back)->ArgName("crlf")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Normalize_copy)->ArgNames({"crlf", "isa"})->ArgsProduct({{0, 1}, {0, 1, 2}})->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Normalize_in_place)
+        ->ArgNames({"crlf", "isa"})
+        ->ArgsProduct({{0, 1}, {0, 1, 2}})
+        ->Unit(benchmark::kMillisecond);
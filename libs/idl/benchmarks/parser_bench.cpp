@@ -0,0 +1,177 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+
+#include "allocation_counter.hpp"
+#include "bench_support.hpp"
+#include "corpus_generator.hpp"
+#include "parser/idl/arena.hpp"
+#include "parser/idl/parallel_parser.hpp"
+#include "parser/idl/parser.hpp"
+#include "parser/idl/token_reader.hpp"
+#include "parser/idl/trivia_policy.hpp"
+
+using namespace parser::idl;
+
+namespace
+{
+constexpr std::size_t corpus_bytes{1UL << 20};
+
+const std::string& corpus()
+{
+    static const std::string corpus{bench::make_corpus(corpus_bytes)};
+
+    return corpus;
+}
+
+/**
+ * Tokenize and parse the corpus into an arena reused across iterations. Reports heap allocations per parse, which
+ * excludes the arena's blocks once it has grown to size, and the arena bytes per source byte.
+ */
+void BM_Parse(benchmark::State& state)
+{
+    Token_reader reader{bench::build_lexer(), corpus()};
+
+    Arena arena;
+
+    std::size_t allocations{0};
+
+    std::size_t arena_bytes{0};
+
+    for (auto _ : state)
+    {
+        reader.reset();
+
+        arena.reset();
+
+        const auto before{bench::allocations()};
+
+        Parser parser{reader, arena};
+
+        const auto result{parser.parse()};
+
+        allocations += bench::allocations() - before;
+
+        arena_bytes = arena.bytes();
+
+        if (!result)
+        {
+            state.SkipWithError(result.error().message.c_str());
+
+            break;
+        }
+
+        benchmark::DoNotOptimize(result.value());
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * corpus().size()));
+    state.counters["allocations"] = benchmark::Counter(
+            static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+    state.counters["arena_bytes_per_byte"] = static_cast<double>(arena_bytes) / static_cast<double>(corpus().size());
+}
+
+/**
+ * Parse a comment-heavy corpus from a reader whose own policy keeps comments (`policy:0`) or already skips them
+ * (`policy:1`). The parser runs the reader with comments skipped either way, so both take the same time: no
+ * comment reaches the parser and it does no per-token filtering of its own.
+ */
+void BM_Parse_comments(benchmark::State& state)
+{
+    static const std::string corpus{bench::generate_corpus({.shape = bench::Corpus_shape::Comment_heavy})};
+
+    Token_reader reader{bench::build_lexer(), corpus};
+
+    reader.set_trivia(state.range(0) == 0 ? keep_comments : skip_comments);
+
+    Arena arena;
+
+    for (auto _ : state)
+    {
+        reader.reset();
+
+        arena.reset();
+
+        Parser parser{reader, arena};
+
+        const auto result{parser.parse()};
+
+        if (!result)
+        {
+            state.SkipWithError(result.error().message.c_str());
+
+            break;
+        }
+
+        benchmark::DoNotOptimize(result.value());
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * corpus.size()));
+}
+
+/**
+ * Reference: pulling the same tokens through Token_reader::next() without building a tree; the difference in
+ * allocations is what the parser itself adds.
+ */
+void BM_Tokenize_only(benchmark::State& state)
+{
+    Token_reader reader{bench::build_lexer(), corpus()};
+
+    std::size_t allocations{0};
+
+    for (auto _ : state)
+    {
+        reader.reset();
+
+        const auto before{bench::allocations()};
+
+        for (auto expected{reader.next()}; expected && *expected; expected = reader.next())
+        {
+            benchmark::DoNotOptimize(expected->value().kind());
+        }
+
+        allocations += bench::allocations() - before;
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * corpus().size()));
+    state.counters["allocations"] = benchmark::Counter(
+            static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+}
+
+/**
+ * Parse the corpus split at top-level definitions on `state.range(0)` threads. Each iteration includes copying the
+ * corpus into the parser, which the sequential benchmarks do once outside the loop.
+ */
+void BM_Parallel_parse(benchmark::State& state)
+{
+    Parallel_parser parser{
+            std::make_shared<const lexer::core::Lexer>(bench::build_lexer()), static_cast<std::size_t>(state.range(0))};
+
+    std::size_t regions{0};
+
+    for (auto _ : state)
+    {
+        const auto result{parser.parse(corpus())};
+
+        if (!result)
+        {
+            state.SkipWithError(result.error().message.c_str());
+
+            break;
+        }
+
+        regions = parser.regions().size();
+
+        benchmark::DoNotOptimize(result.value());
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * corpus().size()));
+    state.counters["regions"] = static_cast<double>(regions);
+}
+
+} // namespace
+
+BENCHMARK(BM_Parse)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Parse_comments)->ArgName("policy")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Tokenize_only)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Parallel_parse)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,149 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <ranges>
+#include <string>
+
+#include "bench_support.hpp"
+#include "parser/idl/token_range.hpp"
+#include "parser/idl/token_reader.hpp"
+
+using namespace parser::idl;
+
+namespace
+{
+constexpr std::size_t corpus_bytes{1UL << 20};
+
+const std::string& corpus()
+{
+    static const std::string corpus{bench::make_corpus(corpus_bytes)};
+
+    return corpus;
+}
+
+/**
+ * Kinds a recursive-descent parser typically tests before it commits to a production.
+ */
+constexpr std::array<Token_kind, 4> alternatives{
+        Token_kind::Keyword_module, Token_kind::Keyword_struct, Token_kind::Keyword_const, Token_kind::Identifier};
+
+/**
+ * LL(1) dispatch through `peek()` and `next()`: every test and every consume copies the token out of an `expected`.
+ */
+void BM_Reader_api_peek_next(benchmark::State& state)
+{
+    Token_reader reader{bench::build_lexer(), corpus()};
+
+    std::size_t calls{0};
+
+    for (auto _ : state)
+    {
+        reader.reset();
+
+        for (auto expected{reader.peek()}; expected && *expected; expected = reader.peek())
+        {
+            for (const auto kind : alternatives)
+            {
+                const auto token{reader.peek()};
+
+                benchmark::DoNotOptimize(token && *token && (*token)->kind() == kind);
+            }
+
+            benchmark::DoNotOptimize(reader.next());
+
+            calls += alternatives.size() + 2;
+        }
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * corpus().size()));
+    state.counters["calls"] = benchmark::Counter(static_cast<double>(calls), benchmark::Counter::kIsRate);
+}
+
+/**
+ * The same dispatch through `current()`, `check()` and `accept()`, which read the buffered token in place.
+ */
+void BM_Reader_api_current_accept(benchmark::State& state)
+{
+    Token_reader reader{bench::build_lexer(), corpus()};
+
+    std::size_t calls{0};
+
+    for (auto _ : state)
+    {
+        reader.reset();
+
+        for (const auto* token{reader.current()}; token; token = reader.current())
+        {
+            for (const auto kind : alternatives)
+            {
+                benchmark::DoNotOptimize(reader.check(kind));
+            }
+
+            benchmark::DoNotOptimize(reader.accept(token->kind()));
+
+            calls += alternatives.size() + 2;
+        }
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * corpus().size()));
+    state.counters["calls"] = benchmark::Counter(static_cast<double>(calls), benchmark::Counter::kIsRate);
+}
+
+/**
+ * Reference for the range: counting identifiers with a hand-written `next()` loop.
+ */
+void BM_Reader_api_next_loop(benchmark::State& state)
+{
+    Token_reader reader{bench::build_lexer(), corpus()};
+
+    std::size_t identifiers{0};
+
+    for (auto _ : state)
+    {
+        reader.reset();
+
+        for (auto expected{reader.next()}; expected && *expected; expected = reader.next())
+        {
+            identifiers += expected->value().kind() == Token_kind::Identifier ? 1 : 0;
+        }
+    }
+
+    benchmark::DoNotOptimize(identifiers);
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * corpus().size()));
+}
+
+/**
+ * The same count composed from `Token_range` and `std::views::filter`.
+ */
+void BM_Reader_api_range(benchmark::State& state)
+{
+    Token_reader reader{bench::build_lexer(), corpus()};
+
+    std::size_t identifiers{0};
+
+    for (auto _ : state)
+    {
+        reader.reset();
+
+        for (const auto& token : Token_range{reader} | std::views::filter([](const auto& token) {
+                 return token.kind() == Token_kind::Identifier;
+             }))
+        {
+            benchmark::DoNotOptimize(token);
+
+            ++identifiers;
+        }
+    }
+
+    benchmark::DoNotOptimize(identifiers);
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * corpus().size()));
+}
+
+} // namespace
+
+BENCHMARK(BM_Reader_api_peek_next)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Reader_api_current_accept)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Reader_api_next_loop)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Reader_api_range)->Unit(benchmark::kMillisecond);
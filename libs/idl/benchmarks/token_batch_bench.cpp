@@ -0,0 +1,64 @@
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench_support.hpp"
+#include "parser/idl/token_batch.hpp"
+
+using namespace parser::idl;
+
+namespace
+{
+constexpr std::size_t file_count{64};
+
+/**
+ * A skewed set of files: a few large ones and a long tail of small ones.
+ */
+const std::vector<std::filesystem::path>& files()
+{
+    static const auto files{[] {
+        std::vector<std::filesystem::path> files;
+
+        for (std::size_t index = 0; index < file_count; ++index)
+        {
+            const auto bytes{index % 16 == 0 ? std::size_t{256} << 10 : std::size_t{16} << 10};
+
+            files.push_back(bench::write_corpus(
+                    "parser_idl_bench_batch_" + std::to_string(index) + ".idl", bench::make_corpus(bytes)));
+        }
+
+        return files;
+    }()};
+
+    return files;
+}
+
+void BM_Batch_tokenize(benchmark::State& state)
+{
+    Token_batch batch{bench::build_lexer(), static_cast<std::size_t>(state.range(0))};
+
+    std::size_t bytes{0};
+
+    for (const auto& file : files())
+    {
+        bytes += std::filesystem::file_size(file);
+    }
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(batch.tokenize(files()));
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+}
+
+} // namespace
+
+BENCHMARK(BM_Batch_tokenize)
+        ->ArgName("threads")
+        ->DenseRange(1, static_cast<int64_t>(std::max(std::thread::hardware_concurrency(), 1U)))
+        ->UseRealTime()
+        ->Unit(benchmark::kMillisecond);
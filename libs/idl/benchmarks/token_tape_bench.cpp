@@ -0,0 +1,97 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "bench_support.hpp"
+#include "parser/idl/tape_cursor.hpp"
+#include "parser/idl/token_location.hpp"
+#include "parser/idl/token_reader.hpp"
+
+using namespace parser::idl;
+
+namespace
+{
+constexpr std::size_t corpus_bytes{1UL << 20};
+
+const std::string& corpus()
+{
+    static const std::string corpus{bench::make_corpus(corpus_bytes)};
+
+    return corpus;
+}
+
+/**
+ * Reference: pulling tokens through Token_reader::next(). Memory per token is what a parser holding on to
+ * every token and its location would pay.
+ */
+void BM_Reader_next(benchmark::State& state)
+{
+    Token_reader reader{bench::build_lexer(), corpus()};
+
+    std::size_t tokens{0};
+
+    for (auto _ : state)
+    {
+        reader.reset();
+
+        for (auto expected{reader.next()}; expected && *expected; expected = reader.next())
+        {
+            benchmark::DoNotOptimize(expected->value().kind());
+
+            ++tokens;
+        }
+    }
+
+    state.counters["tokens"] = benchmark::Counter(static_cast<double>(tokens), benchmark::Counter::kIsRate);
+    state.counters["bytes_per_token"] = sizeof(Token_reader::Token_t) + sizeof(Token_location);
+}
+
+void BM_Tape_build(benchmark::State& state)
+{
+    Token_reader reader{bench::build_lexer(), corpus()};
+
+    std::size_t tokens{0};
+
+    double bytes_per_token{0};
+
+    for (auto _ : state)
+    {
+        const auto tape{reader.tape()};
+
+        tokens += tape->size();
+
+        bytes_per_token = static_cast<double>(tape->bytes()) / static_cast<double>(tape->size());
+    }
+
+    state.counters["tokens"] = benchmark::Counter(static_cast<double>(tokens), benchmark::Counter::kIsRate);
+    state.counters["bytes_per_token"] = bytes_per_token;
+}
+
+void BM_Tape_cursor_next(benchmark::State& state)
+{
+    Token_reader reader{bench::build_lexer(), corpus()};
+
+    const auto tape{reader.tape()};
+
+    std::size_t tokens{0};
+
+    for (auto _ : state)
+    {
+        Tape_cursor cursor{*tape};
+
+        for (auto token{cursor.next()}; token; token = cursor.next())
+        {
+            benchmark::DoNotOptimize(token->kind());
+
+            ++tokens;
+        }
+    }
+
+    state.counters["tokens"] = benchmark::Counter(static_cast<double>(tokens), benchmark::Counter::kIsRate);
+}
+
+} // namespace
+
+BENCHMARK(BM_Reader_next)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Tape_build)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Tape_cursor_next)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,117 @@
+#ifndef PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_ARENA_HPP
+#define PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_ARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace parser::idl
+{
+/**
+ * @brief Bump allocator that frees everything it handed out in one shot.
+ *
+ * Memory is carved sequentially out of large blocks, so an allocation is a pointer increment and destruction is
+ * a handful of `delete[]` calls regardless of how many objects were created. Objects are never destroyed
+ * individually, which is why only trivially destructible types may be placed in the arena.
+ */
+class Arena
+{
+public:
+    /**
+     * @brief Default size of each block requested from the heap.
+     */
+    static constexpr std::size_t default_block_size{64UL * 1024};
+
+    /**
+     * @brief Construct an empty arena; no memory is allocated until first use.
+     * @param block_size Size of each block requested from the heap.
+     */
+    explicit Arena(std::size_t block_size = default_block_size) noexcept;
+
+    Arena(const Arena&) = delete;
+
+    Arena& operator=(const Arena&) = delete;
+
+    Arena(Arena&&) noexcept = default;
+
+    Arena& operator=(Arena&&) noexcept = default;
+
+    ~Arena() = default;
+
+    /**
+     * @brief Allocate uninitialized memory that lives until the arena is reset or destroyed.
+     */
+    [[nodiscard]] void* allocate(std::size_t size, std::size_t alignment);
+
+    /**
+     * @brief Construct an object in the arena.
+     */
+    template <typename T, typename... Args>
+    [[nodiscard]] T* create(Args&&... args)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "Arena objects are never destroyed");
+
+        return ::new (allocate(sizeof(T), alignof(T))) T{std::forward<Args>(args)...};
+    }
+
+    /**
+     * @brief Copy a range into contiguous arena storage.
+     */
+    template <typename T>
+    [[nodiscard]] std::span<const T> copy(const std::span<const T> items)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "Arena objects are never destroyed");
+
+        if (items.empty())
+        {
+            return {};
+        }
+
+        auto* const data{static_cast<T*>(allocate(items.size_bytes(), alignof(T)))};
+
+        std::uninitialized_copy(items.begin(), items.end(), data);
+
+        return {data, items.size()};
+    }
+
+    /**
+     * @brief Release everything allocated so far, keeping the first block for reuse.
+     */
+    void reset() noexcept;
+
+    /**
+     * @brief Number of blocks currently requested from the heap.
+     */
+    [[nodiscard]] std::size_t blocks() const noexcept;
+
+    /**
+     * @brief Bytes handed out since construction or the last `reset()`, including alignment padding.
+     */
+    [[nodiscard]] std::size_t bytes() const noexcept;
+
+private:
+    struct Block
+    {
+        std::unique_ptr<std::byte[]> data;
+
+        std::size_t size;
+    };
+
+    std::vector<Block> blocks_;
+
+    std::byte* cursor_{nullptr};
+
+    std::byte* end_{nullptr};
+
+    std::size_t block_size_;
+
+    std::size_t bytes_{0};
+};
+
+} // namespace parser::idl
+
+#endif // PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_ARENA_HPP
@@ -0,0 +1,282 @@
+#ifndef PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_AST_HPP
+#define PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_AST_HPP
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+#include "tokens.hpp"
+
+/**
+ * @brief Abstract syntax tree of an IDL translation unit.
+ *
+ * Nodes are plain, trivially destructible aggregates allocated in an `Arena` by the `Parser` and freed together
+ * with it. Names and literals are views into the source buffer of the `Token_reader` that was parsed, and child
+ * lists are contiguous spans in the arena, so the tree holds no owning pointers. Since a name is a view into the
+ * source, its position is recovered from its address relative to the start of the buffer.
+ */
+namespace parser::idl::ast
+{
+/**
+ * @brief A possibly qualified name such as `a::b::c`, one part per identifier.
+ */
+struct Scoped_name
+{
+    std::span<const std::string_view> parts;
+};
+
+enum class Expression_kind : uint8_t
+{
+    Literal,
+    Name,
+    Unary,
+    Binary,
+};
+
+/**
+ * @brief Constant expression.
+ *
+ * `op` holds the literal's token kind for literals and the operator for unary and binary expressions; `text` is
+ * the literal's lexeme, `name` the referenced constant, and `left`/`right` the operands.
+ */
+struct Expression
+{
+    Expression_kind kind{Expression_kind::Literal};
+
+    Token_kind op{Token_kind::Integer_literal};
+
+    std::string_view text{};
+
+    Scoped_name name{};
+
+    const Expression* left{nullptr};
+
+    const Expression* right{nullptr};
+};
+
+enum class Type_kind : uint8_t
+{
+    Primitive,
+    String,
+    Wide_string,
+    Sequence,
+    Named,
+};
+
+enum class Primitive : uint8_t
+{
+    Short,
+    Long,
+    Long_long,
+    Unsigned_short,
+    Unsigned_long,
+    Unsigned_long_long,
+    Float,
+    Double,
+    Long_double,
+    Boolean,
+    Char,
+    Wide_char,
+    Octet,
+    Any,
+    Void,
+};
+
+/**
+ * @brief Type reference: a primitive, a (bounded) string, a sequence of `element`, or a named type.
+ *
+ * `bound` is the optional bound of strings and sequences.
+ */
+struct Type_spec
+{
+    Type_kind kind{Type_kind::Primitive};
+
+    Primitive primitive{Primitive::Any};
+
+    const Type_spec* element{nullptr};
+
+    const Expression* bound{nullptr};
+
+    Scoped_name name{};
+};
+
+/**
+ * @brief Declared name with optional array dimensions, e.g. `matrix[3][4]`.
+ */
+struct Declarator
+{
+    std::string_view name;
+
+    std::span<const Expression* const> dimensions;
+};
+
+/**
+ * @brief Member of a struct or exception: one type shared by one or more declarators.
+ */
+struct Member
+{
+    const Type_spec* type;
+
+    std::span<const Declarator> declarators;
+};
+
+/**
+ * @brief Branch of a union; `is_default` is set when one of its labels is `default`.
+ */
+struct Case
+{
+    std::span<const Expression* const> labels;
+
+    bool is_default;
+
+    const Type_spec* type;
+
+    Declarator declarator;
+};
+
+enum class Direction : uint8_t
+{
+    In,
+    Out,
+    Inout,
+};
+
+struct Parameter
+{
+    Direction direction;
+
+    const Type_spec* type;
+
+    std::string_view name;
+};
+
+enum class Definition_kind : uint8_t
+{
+    Module,
+    Interface,
+    Struct,
+    Union,
+    Enum,
+    Typedef,
+    Const,
+    Exception,
+    Attribute,
+    Operation,
+};
+
+/**
+ * @brief Common header of every definition; `kind` tells which derived node it is.
+ *
+ * For typedefs and attributes declaring several names, `name` is the first one.
+ */
+struct Definition
+{
+    Definition_kind kind;
+
+    std::string_view name;
+
+    /**
+     * @brief The derived node if this definition is one, `nullptr` otherwise.
+     */
+    template <typename T>
+    [[nodiscard]] const T* as() const noexcept
+    {
+        return kind == T::tag ? static_cast<const T*>(this) : nullptr;
+    }
+};
+
+struct Module : Definition
+{
+    static constexpr Definition_kind tag{Definition_kind::Module};
+
+    std::span<const Definition* const> definitions;
+};
+
+struct Interface : Definition
+{
+    static constexpr Definition_kind tag{Definition_kind::Interface};
+
+    std::span<const Scoped_name> bases;
+
+    std::span<const Definition* const> exports;
+};
+
+struct Struct : Definition
+{
+    static constexpr Definition_kind tag{Definition_kind::Struct};
+
+    std::span<const Member> members;
+};
+
+struct Union : Definition
+{
+    static constexpr Definition_kind tag{Definition_kind::Union};
+
+    const Type_spec* discriminator;
+
+    std::span<const Case> cases;
+};
+
+struct Enum : Definition
+{
+    static constexpr Definition_kind tag{Definition_kind::Enum};
+
+    std::span<const std::string_view> enumerators;
+};
+
+struct Typedef : Definition
+{
+    static constexpr Definition_kind tag{Definition_kind::Typedef};
+
+    const Type_spec* type;
+
+    std::span<const Declarator> declarators;
+};
+
+struct Const : Definition
+{
+    static constexpr Definition_kind tag{Definition_kind::Const};
+
+    const Type_spec* type;
+
+    const Expression* value;
+};
+
+struct Exception : Definition
+{
+    static constexpr Definition_kind tag{Definition_kind::Exception};
+
+    std::span<const Member> members;
+};
+
+struct Attribute : Definition
+{
+    static constexpr Definition_kind tag{Definition_kind::Attribute};
+
+    const Type_spec* type;
+
+    std::span<const std::string_view> names;
+};
+
+struct Operation : Definition
+{
+    static constexpr Definition_kind tag{Definition_kind::Operation};
+
+    const Type_spec* result;
+
+    std::span<const Parameter> parameters;
+
+    std::span<const Scoped_name> raises;
+};
+
+/**
+ * @brief Root of a translation unit.
+ */
+struct Specification
+{
+    std::span<const Definition* const> definitions;
+};
+
+} // namespace parser::idl::ast
+
+#endif // PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_AST_HPP
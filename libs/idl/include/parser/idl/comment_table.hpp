@@ -0,0 +1,89 @@
+#ifndef PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_COMMENT_TABLE_HPP
+#define PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_COMMENT_TABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "tokens.hpp"
+
+namespace parser::idl
+{
+/**
+ * @brief Comments filtered out of a token stream, keyed by the index of the token that follows them.
+ *
+ * Filled by a `Token_reader` whose trivia policy records comments (see `collect_comments`). Token indices count
+ * the tokens the reader lexed and returned, from 0 at the start of the input; comments after the last token are
+ * keyed by the total token count. The text of every comment is copied into one buffer owned by the table, so
+ * entries stay valid after the reader moves on, and each entry takes 12 bytes.
+ */
+class Comment_table
+{
+public:
+    /**
+     * @brief One recorded comment.
+     */
+    struct Entry
+    {
+        /**
+         * @brief Index of the token following the comment.
+         */
+        uint32_t token;
+
+        /**
+         * @brief Position of the comment text in the table's buffer.
+         */
+        uint32_t offset;
+
+        uint32_t length;
+    };
+
+    /**
+     * @brief Number of recorded comments.
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /**
+     * @brief Returns true if no comment was recorded.
+     */
+    [[nodiscard]] bool empty() const noexcept;
+
+    /**
+     * @brief All recorded comments, in source order.
+     */
+    [[nodiscard]] std::span<const Entry> entries() const noexcept;
+
+    /**
+     * @brief The comments directly preceding token `token`, in source order.
+     */
+    [[nodiscard]] std::span<const Entry> before(std::size_t token) const noexcept;
+
+    /**
+     * @brief Full text of a comment, delimiters included.
+     */
+    [[nodiscard]] std::string_view text(const Entry& entry) const noexcept;
+
+    /**
+     * @brief Append a comment preceding token `token`; tokens must be added in non-decreasing order.
+     *
+     * @throws std::length_error If the comment text or the buffer exceeds the 32-bit offsets.
+     */
+    void add(std::size_t token, std::string_view text);
+
+    /**
+     * @brief Remove all comments.
+     */
+    void clear() noexcept;
+
+private:
+    std::vector<Entry> entries_;
+
+    std::string text_;
+};
+
+} // namespace parser::idl
+
+#endif // PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_COMMENT_TABLE_HPP
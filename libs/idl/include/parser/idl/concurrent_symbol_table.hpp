@@ -0,0 +1,120 @@
+#ifndef PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_CONCURRENT_SYMBOL_TABLE_HPP
+#define PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_CONCURRENT_SYMBOL_TABLE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+
+#include "arena.hpp"
+#include "symbol_table.hpp"
+
+namespace parser::idl
+{
+/**
+ * @brief `Symbol_table` that any number of threads may intern into at once.
+ *
+ * Names are spread over independently locked shards by hash, so threads interning different names rarely wait
+ * on each other, and a name already present is found under a shared lock. IDs are drawn from one atomic counter
+ * and therefore stay dense across shards, and `spelling()` reads an append-only directory without locking.
+ * Used by `Token_batch` so that every file of a batch shares one ID space.
+ */
+class Concurrent_symbol_table
+{
+public:
+    /**
+     * @brief Construct a table holding the well-known names followed by `seeds`.
+     * @param seeds Additional names to intern up front, in order; duplicates keep their first ID.
+     */
+    explicit Concurrent_symbol_table(std::span<const std::string_view> seeds = {});
+
+    Concurrent_symbol_table(const Concurrent_symbol_table&) = delete;
+
+    Concurrent_symbol_table& operator=(const Concurrent_symbol_table&) = delete;
+
+    ~Concurrent_symbol_table() = default;
+
+    /**
+     * @brief ID of `name`, interning it if it was not seen before. Thread-safe.
+     * @throws std::length_error If the table already holds `no_symbol` names.
+     */
+    Symbol_id intern(std::string_view name);
+
+    /**
+     * @brief ID of `name` if it was interned, without adding it. Thread-safe.
+     */
+    [[nodiscard]] std::optional<Symbol_id> find(std::string_view name) const;
+
+    /**
+     * @brief Spelling of an interned name. Lock-free.
+     *
+     * `symbol` must have been returned by `intern()` or `find()` on this thread, or on a thread this one has
+     * synchronized with since (e.g. by joining it).
+     */
+    [[nodiscard]] std::string_view spelling(Symbol_id symbol) const noexcept;
+
+    /**
+     * @brief Number of distinct names interned so far.
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+private:
+    /**
+     * @brief Number of independently locked shards; a power of two.
+     */
+    static constexpr std::size_t shard_count{64};
+
+    /**
+     * @brief Entries in the first directory chunk; each further chunk is twice as large as the one before.
+     */
+    static constexpr std::size_t first_chunk{1024};
+
+    /**
+     * @brief Number of directory chunks needed to hold `no_symbol` entries.
+     */
+    static constexpr std::size_t chunk_count{23};
+
+    struct Shard
+    {
+        mutable std::shared_mutex mutex;
+
+        /**
+         * @brief Names of this shard, as views into `arena`, mapped to their IDs.
+         */
+        std::unordered_map<std::string_view, Symbol_id> symbols;
+
+        Arena arena;
+    };
+
+    /**
+     * @brief Record the spelling of a new ID in the directory, allocating its chunk on first use.
+     */
+    void publish(Symbol_id symbol, std::string_view name);
+
+    /**
+     * @brief Directory chunk holding `symbol` and the index of its entry within that chunk.
+     */
+    [[nodiscard]] static std::pair<std::size_t, std::size_t> locate(Symbol_id symbol) noexcept;
+
+    [[nodiscard]] static std::size_t shard(std::size_t hash) noexcept;
+
+    std::array<Shard, shard_count> shards_;
+
+    std::atomic<Symbol_id> next_{0};
+
+    /**
+     * @brief Spellings indexed by ID, in chunks that are never moved or freed before the table.
+     */
+    std::array<std::atomic<std::string_view*>, chunk_count> chunks_{};
+
+    std::array<std::unique_ptr<std::string_view[]>, chunk_count> owned_;
+};
+
+} // namespace parser::idl
+
+#endif // PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_CONCURRENT_SYMBOL_TABLE_HPP
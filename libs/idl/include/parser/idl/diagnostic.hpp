@@ -0,0 +1,31 @@
+#ifndef PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_DIAGNOSTIC_HPP
+#define PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_DIAGNOSTIC_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+
+namespace parser::idl
+{
+/**
+ * @brief A problem found while reading, tokenizing or parsing an input, with its position.
+ *
+ * Line and column are 1-based; all position fields are zero when the problem is not tied to a position in the
+ * text (e.g. the file could not be opened).
+ */
+struct Diagnostic
+{
+    std::filesystem::path file;
+
+    std::size_t offset{0};
+
+    std::size_t line{0};
+
+    std::size_t column{0};
+
+    std::string message;
+};
+
+} // namespace parser::idl
+
+#endif // PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_DIAGNOSTIC_HPP
@@ -0,0 +1,146 @@
+#ifndef PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_FILE_PREFETCHER_HPP
+#define PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_FILE_PREFETCHER_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <expected>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "diagnostic.hpp"
+
+namespace parser::idl
+{
+/**
+ * @brief Reads and normalizes a list of files on a background thread while the caller works on earlier ones.
+ *
+ * A single I/O thread loads the files in order into a bounded queue of at most `depth` buffers and waits whenever
+ * the queue is full, so the caller's tokenizing and parsing applies back-pressure and memory stays bounded by the
+ * `depth` largest files. Buffers are handed out already normalized; passing them to
+ * `Token_reader::load(std::string&&)` adopts them without another copy:
+ *
+ * @code
+ * File_prefetcher files{paths};
+ *
+ * while (auto text{files.next()})
+ * {
+ *     if (*text)
+ *     {
+ *         reader.load(std::move(**text));
+ *         ...
+ *     }
+ * }
+ * @endcode
+ */
+class File_prefetcher
+{
+public:
+    /**
+     * @brief Normalized contents of a file, or the diagnostic explaining why it could not be read.
+     */
+    using Result_t = std::expected<std::string, Diagnostic>;
+
+    /**
+     * @brief Loads one file; called on the I/O thread. Failures are reported through its result, and an exception it
+     * throws becomes a diagnostic for that file.
+     */
+    using Source_t = std::function<Result_t(const std::filesystem::path& file)>;
+
+    /**
+     * @brief Default number of files read ahead.
+     */
+    static constexpr std::size_t default_depth{4};
+
+    /**
+     * @brief Start prefetching `files` from the file system.
+     * @param files Paths of the files to load, in the order `next()` returns them.
+     * @param depth Maximum number of loaded files waiting to be taken (at least one).
+     */
+    explicit File_prefetcher(std::vector<std::filesystem::path> files, std::size_t depth = default_depth);
+
+    /**
+     * @brief Start prefetching `files` through a custom source, e.g. a content store or a throttled test double.
+     */
+    File_prefetcher(std::vector<std::filesystem::path> files, Source_t source, std::size_t depth = default_depth);
+
+    File_prefetcher(const File_prefetcher&) = delete;
+
+    File_prefetcher& operator=(const File_prefetcher&) = delete;
+
+    /**
+     * @brief Stop the I/O thread after the file it is reading, discarding files not taken yet.
+     */
+    ~File_prefetcher();
+
+    /**
+     * @brief Take the next file, waiting for the I/O thread if it is not loaded yet.
+     *
+     * @return The file's contents or diagnostic, in input order; `std::nullopt` once every file was taken.
+     */
+    [[nodiscard]] std::optional<Result_t> next();
+
+    /**
+     * @brief The paths being loaded.
+     */
+    [[nodiscard]] const std::vector<std::filesystem::path>& files() const noexcept;
+
+    /**
+     * @brief Maximum number of loaded files waiting to be taken.
+     */
+    [[nodiscard]] std::size_t depth() const noexcept;
+
+    /**
+     * @brief Memory-map (or read) and normalize a file; the default source.
+     */
+    [[nodiscard]] static Result_t load(const std::filesystem::path& file);
+
+private:
+    /**
+     * @brief Load `file` through the source, turning an exception into a diagnostic for it.
+     */
+    [[nodiscard]] Result_t read(const std::filesystem::path& file) const;
+
+    /**
+     * @brief Body of the I/O thread.
+     */
+    void work();
+
+    std::vector<std::filesystem::path> files_;
+
+    Source_t source_;
+
+    std::size_t depth_;
+
+    std::mutex mutex_;
+
+    /**
+     * @brief Signals the I/O thread that the queue has room or that it must stop.
+     */
+    std::condition_variable room_;
+
+    /**
+     * @brief Signals the caller that a file was loaded.
+     */
+    std::condition_variable ready_;
+
+    std::deque<Result_t> queue_;
+
+    /**
+     * @brief Number of files taken by `next()`.
+     */
+    std::size_t taken_{0};
+
+    bool stop_{false};
+
+    std::jthread thread_;
+};
+
+} // namespace parser::idl
+
+#endif // PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_FILE_PREFETCHER_HPP
@@ -0,0 +1,33 @@
+#ifndef PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_ISA_HPP
+#define PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_ISA_HPP
+
+#include <cstdint>
+
+namespace parser::idl
+{
+/**
+ * @brief Instruction sets the vectorized scanners can run on.
+ *
+ * Kernels are compiled for every member and selected at runtime, so a single binary runs on any x86-64 CPU and
+ * falls back to scalar code elsewhere.
+ */
+enum class Isa : uint8_t
+{
+    Scalar,
+    Sse2,
+    Avx2,
+};
+
+/**
+ * @brief The widest instruction set supported by the running CPU.
+ */
+[[nodiscard]] Isa detected_isa() noexcept;
+
+/**
+ * @brief Returns true if the running CPU can execute the given instruction set.
+ */
+[[nodiscard]] bool isa_supported(Isa isa) noexcept;
+
+} // namespace parser::idl
+
+#endif // PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_ISA_HPP
@@ -0,0 +1,233 @@
+#ifndef PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_KEYWORDS_HPP
+#define PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_KEYWORDS_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include "tokens.hpp"
+
+namespace parser::idl
+{
+/**
+ * @brief The IDL keyword set and its classification by a compile-time perfect hash.
+ *
+ * Keywords are the contiguous `Keyword_*` range of `Token_kind`; `table` lists their spellings in enum order,
+ * which is checked at compile time. `classify()` maps an identifier to its keyword kind with one hash, one
+ * table lookup and one string comparison, so the lexer only needs an `Identifier` rule instead of one DFA rule
+ * per keyword.
+ */
+class Keywords
+{
+public:
+    /**
+     * @brief A keyword spelling and the token kind it is classified as.
+     */
+    struct Entry
+    {
+        std::string_view spelling;
+
+        Token_kind kind;
+    };
+
+    static constexpr Token_kind first{Token_kind::Keyword_interface};
+
+    static constexpr Token_kind last{Token_kind::Keyword_void};
+
+    static constexpr std::size_t count{static_cast<std::size_t>(last) - static_cast<std::size_t>(first) + 1};
+
+    /**
+     * @brief Every keyword, in `Token_kind` order.
+     */
+    static constexpr std::array<Entry, count> table{{
+            {"interface", Token_kind::Keyword_interface},
+            {"attribute", Token_kind::Keyword_attribute},
+            {"operation", Token_kind::Keyword_operation},
+            {"exception", Token_kind::Keyword_exception},
+            {"raises", Token_kind::Keyword_raises},
+            {"in", Token_kind::Keyword_in},
+            {"out", Token_kind::Keyword_out},
+            {"inout", Token_kind::Keyword_inout},
+            {"module", Token_kind::Keyword_module},
+            {"const", Token_kind::Keyword_const},
+            {"typedef", Token_kind::Keyword_typedef},
+            {"struct", Token_kind::Keyword_struct},
+            {"union", Token_kind::Keyword_union},
+            {"switch", Token_kind::Keyword_switch},
+            {"case", Token_kind::Keyword_case},
+            {"default", Token_kind::Keyword_default},
+            {"enum", Token_kind::Keyword_enum},
+            {"sequence", Token_kind::Keyword_sequence},
+            {"string", Token_kind::Keyword_string},
+            {"wstring", Token_kind::Keyword_wstring},
+            {"any", Token_kind::Keyword_any},
+            {"octet", Token_kind::Keyword_octet},
+            {"long", Token_kind::Keyword_long},
+            {"short", Token_kind::Keyword_short},
+            {"unsigned", Token_kind::Keyword_unsigned},
+            {"float", Token_kind::Keyword_float},
+            {"double", Token_kind::Keyword_double},
+            {"boolean", Token_kind::Keyword_boolean},
+            {"char", Token_kind::Keyword_char},
+            {"wchar", Token_kind::Keyword_wchar},
+            {"void", Token_kind::Keyword_void},
+    }};
+
+    /**
+     * @brief Returns true if the kind is one of the `Keyword_*` kinds.
+     */
+    [[nodiscard]] static constexpr bool is_keyword(const Token_kind kind) noexcept
+    {
+        return kind >= first && kind <= last;
+    }
+
+    /**
+     * @brief Spelling of a keyword kind; empty for any other kind.
+     */
+    [[nodiscard]] static constexpr std::string_view spelling(const Token_kind kind) noexcept
+    {
+        return is_keyword(kind) ? table[static_cast<std::size_t>(kind) - static_cast<std::size_t>(first)].spelling
+                                : std::string_view{};
+    }
+
+    /**
+     * @brief The keyword kind spelled by `identifier`, if any.
+     */
+    [[nodiscard]] static constexpr std::optional<Token_kind> classify(const std::string_view identifier) noexcept
+    {
+        if (identifier.size() < min_length || identifier.size() > max_length)
+        {
+            return std::nullopt;
+        }
+
+        const auto slot{slots[hash(identifier, multipliers)]};
+
+        if (slot == empty || table[slot].spelling != identifier)
+        {
+            return std::nullopt;
+        }
+
+        return table[slot].kind;
+    }
+
+    /**
+     * @brief Kind to report for a lexed token: an `Identifier` spelling a keyword becomes that keyword.
+     */
+    [[nodiscard]] static constexpr Token_kind resolve(const Token_kind kind, const std::string_view lexeme) noexcept
+    {
+        return kind == Token_kind::Identifier ? classify(lexeme).value_or(kind) : kind;
+    }
+
+private:
+    /**
+     * @brief Multipliers of the first and last character in the hash.
+     */
+    struct Multipliers
+    {
+        uint32_t first;
+
+        uint32_t last;
+    };
+
+    static constexpr std::size_t slot_count{64};
+
+    static constexpr uint8_t empty{0xff};
+
+    static constexpr uint32_t hash(const std::string_view text, const Multipliers multipliers) noexcept
+    {
+        return (static_cast<uint8_t>(text.front()) * multipliers.first +
+                static_cast<uint8_t>(text.back()) * multipliers.last + static_cast<uint32_t>(text.size())) &
+               (slot_count - 1);
+    }
+
+    /**
+     * @brief Search for multipliers that map every keyword to a distinct slot.
+     */
+    static consteval Multipliers find_multipliers()
+    {
+        for (uint32_t first_multiplier = 1; first_multiplier < 256; ++first_multiplier)
+        {
+            for (uint32_t last_multiplier = 1; last_multiplier < 256; ++last_multiplier)
+            {
+                uint64_t used{0};
+
+                bool collision{false};
+
+                for (const auto& entry : table)
+                {
+                    const auto bit{uint64_t{1} << hash(entry.spelling, {first_multiplier, last_multiplier})};
+
+                    collision = collision || (used & bit) != 0;
+
+                    used |= bit;
+                }
+
+                if (!collision)
+                {
+                    return {first_multiplier, last_multiplier};
+                }
+            }
+        }
+
+        throw "Keywords: no perfect hash found";
+    }
+
+    static consteval std::array<uint8_t, slot_count> build_slots()
+    {
+        for (std::size_t index = 0; index < table.size(); ++index)
+        {
+            if (static_cast<std::size_t>(table[index].kind) != static_cast<std::size_t>(first) + index)
+            {
+                throw "Keywords: table must list every Keyword_* kind in enum order";
+            }
+        }
+
+        const auto found{find_multipliers()};
+
+        std::array<uint8_t, slot_count> slots{};
+
+        slots.fill(empty);
+
+        for (std::size_t index = 0; index < table.size(); ++index)
+        {
+            slots[hash(table[index].spelling, found)] = static_cast<uint8_t>(index);
+        }
+
+        return slots;
+    }
+
+    static consteval std::size_t length(const bool longest)
+    {
+        std::size_t result{longest ? 0 : SIZE_MAX};
+
+        for (const auto& entry : table)
+        {
+            result = longest ? std::max(result, entry.spelling.size()) : std::min(result, entry.spelling.size());
+        }
+
+        return result;
+    }
+
+    static const Multipliers multipliers;
+
+    static const std::array<uint8_t, slot_count> slots;
+
+    static const std::size_t min_length;
+
+    static const std::size_t max_length;
+};
+
+constexpr Keywords::Multipliers Keywords::multipliers{Keywords::find_multipliers()};
+
+constexpr std::array<uint8_t, Keywords::slot_count> Keywords::slots{Keywords::build_slots()};
+
+constexpr std::size_t Keywords::min_length{Keywords::length(false)};
+
+constexpr std::size_t Keywords::max_length{Keywords::length(true)};
+
+} // namespace parser::idl
+
+#endif // PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_KEYWORDS_HPP
@@ -0,0 +1,42 @@
+#ifndef PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_LEXER_FACTORY_HPP
+#define PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_LEXER_FACTORY_HPP
+
+#include <cstdint>
+#include <lexer/core/builder.hpp>
+
+namespace parser::idl
+{
+/**
+ * @brief Selects how keywords are recognized by the IDL lexer.
+ */
+enum class Keyword_mode : uint8_t
+{
+    /**
+     * Every keyword is a DFA rule with a priority above `Identifier`.
+     */
+    Rules,
+
+    /**
+     * Keywords are lexed as `Identifier` and reclassified by `Keywords::classify()`, keeping the DFA small.
+     */
+    Perfect_hash,
+};
+
+/**
+ * @brief Builds lexers recognizing the complete IDL token set.
+ */
+class Lexer_factory
+{
+public:
+    /**
+     * @brief Build an IDL lexer.
+     *
+     * Both modes produce the same token stream through `Token_reader`, which reclassifies identifiers that spell
+     * a keyword.
+     */
+    [[nodiscard]] static lexer::core::Lexer build(Keyword_mode mode = Keyword_mode::Perfect_hash);
+};
+
+} // namespace parser::idl
+
+#endif // PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_LEXER_FACTORY_HPP
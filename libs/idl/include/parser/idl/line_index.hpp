@@ -0,0 +1,76 @@
+#ifndef PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_LINE_INDEX_HPP
+#define PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_LINE_INDEX_HPP
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include "isa.hpp"
+#include "shifted_offsets.hpp"
+#include "utf8.hpp"
+
+namespace parser::idl
+{
+/**
+ * @brief Table of line start offsets for a normalized input.
+ *
+ * Built once per input with a vectorized scan for '\n', after which any byte offset can be turned into a
+ * line and column with a binary search. This lets the reader track only offsets while tokenizing and resolve
+ * positions just for the tokens that end up in a diagnostic.
+ */
+class Line_index
+{
+public:
+    /**
+     * @brief Construct an index for empty input (a single line starting at offset 0).
+     */
+    Line_index();
+
+    /**
+     * @brief Construct an index over the given input.
+     */
+    explicit Line_index(std::string_view input, Isa isa = detected_isa());
+
+    /**
+     * @brief Rebuild the index for new input, reusing the existing storage.
+     */
+    void build(std::string_view input, Isa isa = detected_isa());
+
+    /**
+     * @brief Update the index for an edit of the indexed input.
+     * @param offset Start of the replaced byte range.
+     * @param length Length of the replaced byte range.
+     * @param text   Text that replaced the range.
+     *
+     * Only `text` is scanned; line starts after the range are shifted by the change in length, lazily.
+     */
+    void replace(std::size_t offset, std::size_t length, std::string_view text);
+
+    /**
+     * @brief Line number (1-based) containing the given byte offset.
+     */
+    [[nodiscard]] std::size_t line(std::size_t offset) const noexcept;
+
+    /**
+     * @brief Column number (1-based, in bytes) of the given byte offset.
+     */
+    [[nodiscard]] std::size_t column(std::size_t offset) const noexcept;
+
+    /**
+     * @brief Column number (1-based) of the given byte offset, counted in `unit`.
+     * @param input The indexed input, which the line's text is measured in.
+     */
+    [[nodiscard]] std::size_t column(std::size_t offset, std::string_view input, Column_unit unit) const noexcept;
+
+    /**
+     * @brief Number of lines in the indexed input.
+     */
+    [[nodiscard]] std::size_t lines() const noexcept;
+
+private:
+    Shifted_offsets starts_;
+};
+
+} // namespace parser::idl
+
+#endif // PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_LINE_INDEX_HPP
@@ -0,0 +1,58 @@
+#ifndef PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_MAPPED_FILE_HPP
+#define PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+
+namespace parser::idl
+{
+/**
+ * @brief Read-only memory mapping of a file.
+ *
+ * Maps the whole file into the address space so its contents can be scanned without first being copied into a
+ * std::string. The mapping is released when the object is destroyed. Empty files are represented by an empty view
+ * and no mapping.
+ */
+class Mapped_file
+{
+public:
+    /**
+     * @brief Map the given file read-only.
+     * @param file Path to the file to map.
+     *
+     * @throws std::runtime_error If the file cannot be opened or mapped.
+     */
+    explicit Mapped_file(const std::filesystem::path& file);
+
+    Mapped_file(const Mapped_file&) = delete;
+
+    Mapped_file& operator=(const Mapped_file&) = delete;
+
+    Mapped_file(Mapped_file&& other) noexcept;
+
+    Mapped_file& operator=(Mapped_file&& other) noexcept;
+
+    ~Mapped_file();
+
+    /**
+     * @brief View of the mapped file contents.
+     */
+    [[nodiscard]] std::string_view view() const noexcept;
+
+    /**
+     * @brief Size of the mapped file in bytes.
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+private:
+    void release() noexcept;
+
+    const char* data_;
+
+    std::size_t size_;
+};
+
+} // namespace parser::idl
+
+#endif // PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_MAPPED_FILE_HPP
@@ -0,0 +1,56 @@
+#ifndef PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_NEWLINE_NORMALIZER_HPP
+#define PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_NEWLINE_NORMALIZER_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "isa.hpp"
+
+namespace parser::idl
+{
+/**
+ * @brief Vectorized conversion of "\r\n" and "\r" line endings to '\n'.
+ *
+ * The input is first scanned for '\r'; input without any is returned (or kept) untouched. Otherwise the text is
+ * compacted in wide blocks, copying every block without '\r' as a whole. The instruction set is selected once at
+ * runtime (AVX2, SSE2, or a scalar fallback) and can be overridden, which is what the tests and benchmarks use.
+ */
+class Newline_normalizer
+{
+public:
+    /**
+     * @brief Find the first '\r' in the input.
+     * @return Its index, or std::string_view::npos if the input contains none.
+     */
+    [[nodiscard]] static std::size_t find_carriage_return(std::string_view input, Isa isa = detected_isa()) noexcept;
+
+    /**
+     * @brief Return a normalized copy of the input.
+     *
+     * Input without '\r' is copied in a single block.
+     */
+    [[nodiscard]] static std::string normalize(std::string_view input, Isa isa = detected_isa());
+
+    /**
+     * @brief Normalize a buffer in place.
+     *
+     * The buffer is left untouched when it contains no '\r'; otherwise it is compacted and shrunk to the
+     * normalized length without reallocating.
+     */
+    static void normalize(std::string& buffer, Isa isa = detected_isa()) noexcept;
+
+private:
+    /**
+     * @brief Copy `size` bytes from `source` to `target`, replacing line endings along the way.
+     *
+     * `target` may alias `source`, in which case the compaction happens in place.
+     *
+     * @return Number of bytes written to `target`.
+     */
+    static std::size_t compact(const char* source, std::size_t size, char* target, Isa isa) noexcept;
+};
+
+} // namespace parser::idl
+
+#endif // PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_NEWLINE_NORMALIZER_HPP
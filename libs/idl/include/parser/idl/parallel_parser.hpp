@@ -0,0 +1,160 @@
+#ifndef PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_PARALLEL_PARSER_HPP
+#define PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_PARALLEL_PARSER_HPP
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "arena.hpp"
+#include "line_index.hpp"
+#include "parser.hpp"
+#include "thread_pool.hpp"
+#include "token_reader.hpp"
+
+namespace parser::idl
+{
+/**
+ * @brief Parses one large input on several threads by splitting it between top-level definitions.
+ *
+ * A structural scan first looks for lines starting right after a top-level `;`, outside braces, parentheses,
+ * comments and string literals. The input is cut at some of those lines into regions of similar size, every region
+ * is tokenized and parsed on its own `Token_reader` and `Arena` on a `Thread_pool`, and the top-level definitions
+ * are concatenated in source order. The result is the tree a sequential `Parser` would build.
+ *
+ * Inputs the scan cannot split safely (unbalanced brackets, preprocessor lines, unterminated literals or
+ * comments) and inputs with any error are parsed sequentially, so diagnostics are the sequential ones.
+ */
+class Parallel_parser
+{
+public:
+    using Result_t = Parser::Result_t;
+
+    /**
+     * @brief A range of the input parsed as a unit.
+     */
+    struct Region
+    {
+        std::size_t offset;
+
+        std::size_t length;
+    };
+
+    /**
+     * @brief Default lower bound on the size of a region, below which splitting costs more than it gains.
+     */
+    static constexpr std::size_t default_region_bytes{64UL * 1024};
+
+    /**
+     * @brief Construct a parallel parser.
+     * @param lexer        Shared, immutable lexer used to recognize tokens.
+     * @param threads      Number of worker threads.
+     * @param region_bytes Minimum size of a region.
+     */
+    explicit Parallel_parser(
+            std::shared_ptr<const lexer::core::Lexer> lexer, std::size_t threads = Thread_pool::default_threads(),
+            std::size_t region_bytes = default_region_bytes);
+
+    /**
+     * @brief Parse `text` as one translation unit.
+     *
+     * The tree is allocated in arenas owned by the parser and its names are views into buffers owned by it, so it
+     * stays valid until the next `parse()` or the parser's destruction; use `offset()` to locate a name.
+     */
+    [[nodiscard]] Result_t parse(std::string text);
+
+    /**
+     * @brief Regions of the last `parse()`; a single region covering the input if it was parsed sequentially.
+     */
+    [[nodiscard]] std::span<const Region> regions() const noexcept;
+
+    /**
+     * @brief Normalized text of the last `parse()`.
+     */
+    [[nodiscard]] std::string_view text() const noexcept;
+
+    /**
+     * @brief Offset in `text()` of a name or literal of the last tree.
+     */
+    [[nodiscard]] std::size_t offset(std::string_view name) const noexcept;
+
+    /**
+     * @brief Line (1-based) of an offset in `text()`.
+     */
+    [[nodiscard]] std::size_t line(std::size_t offset) const noexcept;
+
+    /**
+     * @brief Column (1-based) of an offset in `text()`.
+     */
+    [[nodiscard]] std::size_t column(std::size_t offset) const noexcept;
+
+    /**
+     * @brief Number of worker threads.
+     */
+    [[nodiscard]] std::size_t threads() const noexcept;
+
+    /**
+     * @brief Cut `text` into at most `regions` regions of at least `region_bytes` bytes at top-level definitions.
+     *
+     * The scan treats literals and comments as the IDL lexer matches them, i.e. a string literal runs to the last
+     * quote of its line and a block comment to the last comment terminator of the input.
+     *
+     * @return The regions in source order, covering `text`, or `std::nullopt` if `text` cannot be split safely.
+     */
+    [[nodiscard]] static std::optional<std::vector<Region>> split(
+            std::string_view text, std::size_t regions, std::size_t region_bytes = default_region_bytes);
+
+private:
+    /**
+     * @brief Parsed state of one region.
+     */
+    struct Slot
+    {
+        std::unique_ptr<Token_reader> reader;
+
+        Arena arena;
+
+        Result_t result;
+
+        /**
+         * @brief Start of the reader's input buffer, which names of the region's tree point into.
+         */
+        const char* buffer{nullptr};
+    };
+
+    /**
+     * @brief Tokenize and parse `region` into `slot`.
+     */
+    void parse_region(Slot& slot, const Region& region);
+
+    /**
+     * @brief Parse the whole text on the first slot.
+     */
+    [[nodiscard]] Result_t sequential();
+
+    std::shared_ptr<const lexer::core::Lexer> lexer_;
+
+    Thread_pool pool_;
+
+    std::size_t region_bytes_;
+
+    std::string text_;
+
+    Line_index lines_;
+
+    std::vector<Region> regions_;
+
+    std::vector<std::unique_ptr<Slot>> slots_;
+
+    /**
+     * @brief Holds the stitched top-level definition list and the root node.
+     */
+    Arena root_;
+};
+
+} // namespace parser::idl
+
+#endif // PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_PARALLEL_PARSER_HPP
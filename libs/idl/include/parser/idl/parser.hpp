@@ -0,0 +1,172 @@
+#ifndef PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_PARSER_HPP
+#define PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_PARSER_HPP
+
+#include <cstddef>
+#include <expected>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include "arena.hpp"
+#include "ast.hpp"
+#include "diagnostic.hpp"
+#include "token_reader.hpp"
+#include "tokens.hpp"
+
+namespace parser::idl
+{
+/**
+ * @brief Recursive-descent parser turning the tokens of a `Token_reader` into an `ast::Specification`.
+ *
+ * All nodes are allocated in the given arena. Names and literals are views into the reader's input buffer, so the
+ * tree stays valid while both the arena and the reader's current input are alive; streamed input
+ * (`Token_reader::load(Stream_source)`) does not keep its text alive and cannot be parsed. Comments are skipped by
+ * the reader: `parse()` adds them to the kinds its trivia policy skips and restores the policy when it returns, so
+ * a reader using `collect_comments` still records them. Comments the reader buffered beyond the current token
+ * before `parse()` are not filtered, so parse a freshly loaded reader or one that has only looked one token ahead.
+ *
+ * Child lists are collected on per-type scratch stacks reused across the whole parse and copied into the arena
+ * once complete, so a parse performs no heap allocation per node.
+ */
+class Parser
+{
+public:
+    /**
+     * @brief Translation unit on success, or the first lexical or syntax error.
+     */
+    using Result_t = std::expected<const ast::Specification*, Diagnostic>;
+
+    /**
+     * @brief Construct a parser reading from `reader` and allocating in `arena`; both must outlive the parser.
+     */
+    Parser(Token_reader& reader, Arena& arena) noexcept;
+
+    /**
+     * @brief Parse the reader's remaining input as one translation unit.
+     */
+    [[nodiscard]] Result_t parse();
+
+private:
+    using Token_t = Token_reader::Token_t;
+
+    /**
+     * @brief Thrown internally to unwind to `parse()` on the first error.
+     */
+    struct Failure
+    {
+        Diagnostic diagnostic;
+    };
+
+    const ast::Definition* definition();
+
+    const ast::Definition* export_definition();
+
+    const ast::Module* module_definition();
+
+    const ast::Interface* interface_definition();
+
+    const ast::Struct* structure();
+
+    const ast::Union* union_type();
+
+    ast::Case union_case();
+
+    const ast::Enum* enumeration();
+
+    const ast::Typedef* type_definition();
+
+    const ast::Const* constant();
+
+    const ast::Exception* exception();
+
+    const ast::Attribute* attribute();
+
+    const ast::Operation* operation();
+
+    ast::Parameter parameter();
+
+    ast::Member member();
+
+    ast::Declarator declarator();
+
+    const ast::Type_spec* type_spec();
+
+    const ast::Type_spec* primitive(ast::Primitive primitive);
+
+    ast::Scoped_name scoped_name();
+
+    const ast::Expression* expression();
+
+    const ast::Expression* term();
+
+    const ast::Expression* unary();
+
+    const ast::Expression* primary();
+
+    /**
+     * @brief The current token, or `nullptr` at end of input; the reader skips comments during `parse()`.
+     */
+    const Token_t* current();
+
+    /**
+     * @brief Returns true if the current token has the given kind.
+     */
+    bool check(Token_kind kind);
+
+    /**
+     * @brief Consume the current token if it has the given kind.
+     */
+    bool accept(Token_kind kind);
+
+    /**
+     * @brief Consume the current token, failing with "expected `what`" unless it has the given kind.
+     */
+    Token_t expect(Token_kind kind, std::string_view what);
+
+    std::string_view identifier();
+
+    void advance();
+
+    [[noreturn]] void fail(std::string_view expected);
+
+    /**
+     * @brief Scratch stack collecting child lists of type `T`.
+     */
+    template <typename T>
+    std::vector<T>& stack() noexcept
+    {
+        return std::get<std::vector<T>>(stacks_);
+    }
+
+    /**
+     * @brief Move the items pushed onto the scratch stack since `mark` into the arena.
+     */
+    template <typename T>
+    std::span<const T> commit(const std::size_t mark)
+    {
+        auto& items{stack<T>()};
+
+        const auto span{arena_.copy(std::span<const T>{items}.subspan(mark))};
+
+        items.resize(mark);
+
+        return span;
+    }
+
+    Token_reader& reader_;
+
+    Arena& arena_;
+
+    std::tuple<
+            std::vector<const ast::Definition*>, std::vector<const ast::Expression*>, std::vector<std::string_view>,
+            std::vector<ast::Scoped_name>, std::vector<ast::Declarator>, std::vector<ast::Member>,
+            std::vector<ast::Case>, std::vector<ast::Parameter>>
+            stacks_;
+};
+
+} // namespace parser::idl
+
+#endif // PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_PARSER_HPP
@@ -0,0 +1,184 @@
+#ifndef PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_PREPROCESSOR_HPP
+#define PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_PREPROCESSOR_HPP
+
+#include <cstddef>
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <set>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "arena.hpp"
+#include "diagnostic.hpp"
+#include "parser.hpp"
+#include "source_cache.hpp"
+#include "source_manager.hpp"
+#include "token_reader.hpp"
+#include "tokens.hpp"
+
+namespace parser::idl
+{
+/**
+ * @brief The token stream of a root file with its includes expanded in place.
+ *
+ * Stored as a list of token ranges of cached files rather than a copy of the tokens, so a header shared by many
+ * units is held once. Every token keeps the file, line and column it was written at. `parse()` feeds the unit
+ * to a `Token_reader` and `Parser`.
+ */
+class Translation_unit
+{
+public:
+    using Token_t = Token_tape::Token_t;
+
+    /**
+     * @brief A run of consecutive tokens `[first, last)` from one file's tape.
+     */
+    struct Segment
+    {
+        std::shared_ptr<const Source_file> file;
+
+        std::size_t first;
+
+        std::size_t last;
+    };
+
+    /**
+     * @brief Total number of tokens.
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /**
+     * @brief Returns true if the unit holds no tokens.
+     */
+    [[nodiscard]] bool empty() const noexcept;
+
+    [[nodiscard]] Token_kind kind(std::size_t index) const noexcept;
+
+    [[nodiscard]] std::string_view lexeme(std::size_t index) const noexcept;
+
+    [[nodiscard]] Token_t token(std::size_t index) const noexcept;
+
+    /**
+     * @brief Canonical path of the file the token at `index` was read from.
+     */
+    [[nodiscard]] const std::filesystem::path& file(std::size_t index) const noexcept;
+
+    /**
+     * @brief Line (1-based) of the token at `index` within its file.
+     */
+    [[nodiscard]] std::size_t line(std::size_t index) const noexcept;
+
+    /**
+     * @brief Column (1-based) of the token at `index` within its line.
+     */
+    [[nodiscard]] std::size_t column(std::size_t index) const noexcept;
+
+    /**
+     * @brief The token ranges making up the unit, in order.
+     */
+    [[nodiscard]] std::span<const Segment> segments() const noexcept;
+
+    /**
+     * @brief Parse the unit, with its includes expanded, into one specification.
+     *
+     * The text of every segment is loaded into `reader` in unit order, so the tree's names and literals are views
+     * into the reader's input and stay valid while the reader keeps it and `arena` is alive. Errors are reported
+     * at the file, line and column they were written at.
+     */
+    [[nodiscard]] Parser::Result_t parse(Token_reader& reader, Arena& arena) const;
+
+    /**
+     * @brief Compact location of every token, registering each file of the unit with `manager` once.
+     *
+     * Files included several times share one range of the manager's location space.
+     */
+    [[nodiscard]] std::vector<Source_location> locations(Source_manager& manager) const;
+
+private:
+    friend class Preprocessor;
+
+    /**
+     * @brief Append tokens `[first, last)` of `file`; empty ranges are dropped.
+     */
+    void append(const std::shared_ptr<const Source_file>& file, std::size_t first, std::size_t last);
+
+    /**
+     * @brief Segment holding the token at `index` and the token's index on that segment's tape.
+     */
+    [[nodiscard]] std::pair<const Segment*, std::size_t> locate(std::size_t index) const noexcept;
+
+    std::vector<Segment> segments_;
+
+    /**
+     * @brief Unit index of the first token of every segment.
+     */
+    std::vector<std::size_t> starts_;
+
+    std::size_t size_{0};
+};
+
+/**
+ * @brief Expands `#include` directives, reading and lexing every file through a shared `Source_cache`.
+ *
+ * `#include "file"` is looked up relative to the including file first and then in the search paths, in order;
+ * `#include <file>` in the search paths only. A file with `#pragma once`, or whose include guard macro was
+ * already seen, is expanded at most once per unit.
+ */
+class Preprocessor
+{
+public:
+    /**
+     * @brief Result of preprocessing: the expanded unit, or the first problem found.
+     */
+    using Result_t = std::expected<Translation_unit, Diagnostic>;
+
+    /**
+     * @brief Maximum include nesting before a cycle is assumed.
+     */
+    static constexpr std::size_t max_depth{200};
+
+    /**
+     * @brief Construct a preprocessor.
+     * @param search_paths Directories searched for included files.
+     * @param cache        Cache files are loaded through; the process-wide one by default.
+     */
+    explicit Preprocessor(
+            std::vector<std::filesystem::path> search_paths, Source_cache& cache = Source_cache::global());
+
+    /**
+     * @brief Expand the includes of `file`.
+     */
+    [[nodiscard]] Result_t run(const std::filesystem::path& file);
+
+private:
+    /**
+     * @brief Append the tokens of `file` to `unit`, expanding its includes recursively.
+     */
+    [[nodiscard]] std::optional<Diagnostic> expand(
+            const std::shared_ptr<const Source_file>& file, Translation_unit& unit, std::size_t depth);
+
+    /**
+     * @brief Path of the file an include refers to, or empty if it cannot be found.
+     */
+    [[nodiscard]] std::filesystem::path resolve(const Source_file& includer, const Include_directive& include) const;
+
+    std::vector<std::filesystem::path> search_paths_;
+
+    Source_cache& cache_;
+
+    /**
+     * @brief Once-only files and guard macros seen in the current unit.
+     */
+    std::set<std::filesystem::path> once_;
+
+    std::set<std::string> guards_;
+};
+
+} // namespace parser::idl
+
+#endif // PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_PREPROCESSOR_HPP
@@ -0,0 +1,227 @@
+#ifndef PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_READER_METRICS_HPP
+#define PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_READER_METRICS_HPP
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "tokens.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/**
+ * Set to 1 (CMake option PARSER_IDL_METRICS) to count hot-path events in `Token_reader`. When 0, the counters
+ * compile to nothing and `Token_reader::metrics()` always returns zeros.
+ */
+#ifndef PARSER_IDL_METRICS
+#define PARSER_IDL_METRICS 0
+#endif
+
+namespace parser::idl
+{
+/**
+ * @brief Snapshot of the events counted by a `Token_reader` (or summed over the readers of a `Token_batch`).
+ *
+ * All fields stay zero unless the library is built with `PARSER_IDL_METRICS`.
+ */
+struct Reader_metrics
+{
+    /**
+     * @brief Whether the library was built with the counters compiled in.
+     */
+    static constexpr bool enabled{PARSER_IDL_METRICS != 0};
+
+    /**
+     * @brief Number of token kinds; `Multi_line_comment` is the last one.
+     */
+    static constexpr std::size_t kinds{static_cast<std::size_t>(Token_kind::Multi_line_comment) + 1};
+
+    /**
+     * @brief Tokens returned by the tokenizer, trivia included, indexed by `Token_kind`.
+     */
+    std::array<uint64_t, kinds> tokens{};
+
+    /**
+     * @brief Tokens dropped as trivia before reaching the lookahead or a tape.
+     */
+    uint64_t skipped{0};
+
+    /**
+     * @brief Bytes of in-memory input run through newline normalization.
+     */
+    uint64_t bytes_normalized{0};
+
+    /**
+     * @brief Carriage returns rewritten or removed by normalization.
+     */
+    uint64_t carriage_returns{0};
+
+    /**
+     * @brief `peek()` calls answered from already buffered tokens.
+     */
+    uint64_t peek_hits{0};
+
+    /**
+     * @brief Calls into the tokenizer, including the final one reporting end of input or an error.
+     */
+    uint64_t tokenizer_calls{0};
+
+    uint64_t lexical_errors{0};
+
+    /**
+     * @brief Time spent in the tokenizer, in CPU timestamp-counter cycles (steady-clock ticks off x86).
+     */
+    uint64_t tokenizer_cycles{0};
+
+    /**
+     * @brief Time spent advancing line and column locations, in the same unit as `tokenizer_cycles`.
+     */
+    uint64_t location_cycles{0};
+
+    /**
+     * @brief Count of tokens of the given kind.
+     */
+    [[nodiscard]] uint64_t count(Token_kind kind) const noexcept;
+
+    /**
+     * @brief Sum of `tokens` over all kinds.
+     */
+    [[nodiscard]] uint64_t total() const noexcept;
+
+    /**
+     * @brief Add another snapshot, e.g. to aggregate the files of a batch.
+     */
+    Reader_metrics& operator+=(const Reader_metrics& other) noexcept;
+};
+
+/**
+ * @brief Updates a `Reader_metrics`; the disabled specialization is empty and every call is a no-op.
+ */
+template <bool Enabled>
+class Metrics_recorder;
+
+template <>
+class Metrics_recorder<false>
+{
+public:
+    using Stamp_t = int;
+
+    static constexpr Stamp_t now() noexcept
+    {
+        return 0;
+    }
+
+    constexpr void token(Token_kind) noexcept
+    {}
+
+    constexpr void skipped() noexcept
+    {}
+
+    constexpr void normalized(std::string_view) noexcept
+    {}
+
+    constexpr void peek_hit() noexcept
+    {}
+
+    constexpr void tokenizer(Stamp_t) noexcept
+    {}
+
+    constexpr void location(Stamp_t) noexcept
+    {}
+
+    constexpr void error() noexcept
+    {}
+
+    [[nodiscard]] static Reader_metrics snapshot() noexcept
+    {
+        return {};
+    }
+
+    constexpr void reset() noexcept
+    {}
+};
+
+template <>
+class Metrics_recorder<true>
+{
+public:
+    using Stamp_t = uint64_t;
+
+    static Stamp_t now() noexcept
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return static_cast<Stamp_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    void token(const Token_kind kind) noexcept
+    {
+        ++metrics_.tokens[static_cast<std::size_t>(kind)];
+    }
+
+    void skipped() noexcept
+    {
+        ++metrics_.skipped;
+    }
+
+    void normalized(const std::string_view input) noexcept
+    {
+        metrics_.bytes_normalized += input.size();
+
+        for (const auto c : input)
+        {
+            metrics_.carriage_returns += c == '\r' ? 1 : 0;
+        }
+    }
+
+    void peek_hit() noexcept
+    {
+        ++metrics_.peek_hits;
+    }
+
+    /**
+     * @brief Record one tokenizer call that started at `start`.
+     */
+    void tokenizer(const Stamp_t start) noexcept
+    {
+        ++metrics_.tokenizer_calls;
+
+        metrics_.tokenizer_cycles += now() - start;
+    }
+
+    /**
+     * @brief Record location tracking that started at `start`.
+     */
+    void location(const Stamp_t start) noexcept
+    {
+        metrics_.location_cycles += now() - start;
+    }
+
+    void error() noexcept
+    {
+        ++metrics_.lexical_errors;
+    }
+
+    [[nodiscard]] Reader_metrics snapshot() const noexcept
+    {
+        return metrics_;
+    }
+
+    void reset() noexcept
+    {
+        metrics_ = {};
+    }
+
+private:
+    Reader_metrics metrics_;
+};
+
+} // namespace parser::idl
+
+#endif // PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_READER_METRICS_HPP
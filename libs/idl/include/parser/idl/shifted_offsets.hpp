@@ -0,0 +1,74 @@
+#ifndef PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_SHIFTED_OFFSETS_HPP
+#define PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_SHIFTED_OFFSETS_HPP
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace parser::idl
+{
+/**
+ * @brief Sorted text offsets that follow edits of the text without rewriting every offset after each edit.
+ *
+ * An edit replaces the offsets of the changed range and shifts all later ones by the change in length. The shift
+ * is kept pending for the suffix following the last edit and only applied to the entries between that edit and the
+ * next one, so a run of edits costs in proportion to how far apart they are rather than to the size of the text.
+ * Reads add the pending shift on the fly.
+ */
+class Shifted_offsets
+{
+public:
+    /**
+     * @brief Number of offsets.
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /**
+     * @brief Returns true if there are no offsets.
+     */
+    [[nodiscard]] bool empty() const noexcept;
+
+    /**
+     * @brief The offset at `index`.
+     */
+    [[nodiscard]] std::size_t operator[](std::size_t index) const noexcept;
+
+    /**
+     * @brief Index of the first offset greater than `offset`, or `size()`.
+     */
+    [[nodiscard]] std::size_t upper_bound(std::size_t offset) const noexcept;
+
+    /**
+     * @brief Storage for rebuilding the offsets from scratch, with any pending shift applied.
+     */
+    [[nodiscard]] std::vector<std::size_t>& values() noexcept;
+
+    /**
+     * @brief Replace the offsets at `[first, last)` with `inserted` and shift every offset after them by `delta`.
+     *
+     * `delta` is the change in text length and may be negative, taken modulo 2^64.
+     */
+    void splice(std::size_t first, std::size_t last, std::span<const std::size_t> inserted, std::size_t delta);
+
+private:
+    /**
+     * @brief Move the start of the pending shift to `index`, applying or removing it in between.
+     */
+    void settle(std::size_t index) noexcept;
+
+    std::vector<std::size_t> values_;
+
+    /**
+     * @brief First entry the pending shift applies to.
+     */
+    std::size_t from_{0};
+
+    /**
+     * @brief Shift pending for entries from `from_` on; zero when there is none.
+     */
+    std::size_t delta_{0};
+};
+
+} // namespace parser::idl
+
+#endif // PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_SHIFTED_OFFSETS_HPP
@@ -0,0 +1,149 @@
+#ifndef PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_SOURCE_CACHE_HPP
+#define PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_SOURCE_CACHE_HPP
+
+#include <cstddef>
+#include <expected>
+#include <filesystem>
+#include <future>
+#include <lexer/tools/tokenizer/tokenizer.hpp>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "diagnostic.hpp"
+#include "token_tape.hpp"
+
+namespace parser::idl
+{
+/**
+ * @brief An `#include` directive found in a source file.
+ */
+struct Include_directive
+{
+    /**
+     * @brief The path as written between the quotes or angle brackets.
+     */
+    std::string target;
+
+    /**
+     * @brief True for `<...>`, which is looked up in the search paths only.
+     */
+    bool angled{false};
+
+    /**
+     * @brief Line (1-based) of the directive.
+     */
+    std::size_t line{0};
+
+    /**
+     * @brief Index of the first token of the file's tape that follows the directive.
+     */
+    std::size_t token{0};
+};
+
+/**
+ * @brief A source file read, scanned for preprocessor directives and tokenized once.
+ *
+ * Directive lines are blanked before lexing, so tokens keep the offsets, lines and columns they have in the file.
+ * Supported directives are `#include`, `#pragma once` (other pragmas are ignored) and an include guard made of
+ * `#ifndef`/`#define` before the first token and `#endif` after the last one.
+ */
+struct Source_file
+{
+    /**
+     * @brief Canonical path of the file.
+     */
+    std::filesystem::path path;
+
+    /**
+     * @brief Modification time the contents were read at.
+     */
+    std::filesystem::file_time_type modified;
+
+    /**
+     * @brief Detached tape of the file's tokens, with its line index.
+     */
+    Token_tape tape;
+
+    /**
+     * @brief Include directives, in source order.
+     */
+    std::vector<Include_directive> includes;
+
+    bool pragma_once{false};
+
+    /**
+     * @brief Macro of the file's include guard, or empty.
+     */
+    std::string guard;
+};
+
+/**
+ * @brief Thread-safe cache of loaded and tokenized source files, keyed by canonical path and modification time.
+ *
+ * A file is read and lexed at most once while it is unchanged, however many translation units include it and on
+ * however many threads; concurrent requests for a file being loaded wait for the first one. Failures (unreadable
+ * file, lexical error) are cached as well.
+ */
+class Source_cache
+{
+public:
+    /**
+     * @brief Shared pointer to a cached file, or the diagnostic that prevented loading it.
+     */
+    using Result_t = std::expected<std::shared_ptr<const Source_file>, Diagnostic>;
+
+    /**
+     * @brief Construct an empty cache lexing files with the given compiled lexer.
+     */
+    explicit Source_cache(std::shared_ptr<const lexer::core::Lexer> lexer);
+
+    Source_cache(const Source_cache&) = delete;
+
+    Source_cache& operator=(const Source_cache&) = delete;
+
+    /**
+     * @brief The process-wide cache, using the library's IDL lexer (see `Lexer_factory`).
+     */
+    [[nodiscard]] static Source_cache& global();
+
+    /**
+     * @brief The cached file at `file`, loading it if absent or modified since it was cached.
+     */
+    [[nodiscard]] Result_t load(const std::filesystem::path& file);
+
+    /**
+     * @brief Number of cached files.
+     */
+    [[nodiscard]] std::size_t size() const;
+
+    /**
+     * @brief Drop every cached file; files already handed out stay alive while referenced.
+     */
+    void clear();
+
+private:
+    struct Entry
+    {
+        std::filesystem::file_time_type modified;
+
+        std::shared_future<Result_t> result;
+    };
+
+    /**
+     * @brief Read, scan and tokenize a file.
+     */
+    [[nodiscard]] Result_t read(const std::filesystem::path& canonical, std::filesystem::file_time_type modified) const;
+
+    std::shared_ptr<const lexer::core::Lexer> lexer_;
+
+    mutable std::mutex mutex_;
+
+    std::map<std::filesystem::path, Entry> entries_;
+};
+
+} // namespace parser::idl
+
+#endif // PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_SOURCE_CACHE_HPP
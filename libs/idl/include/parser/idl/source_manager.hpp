@@ -0,0 +1,183 @@
+#ifndef PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_SOURCE_MANAGER_HPP
+#define PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_SOURCE_MANAGER_HPP
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "diagnostic.hpp"
+#include "line_index.hpp"
+
+namespace parser::idl
+{
+/**
+ * @brief Dense identifier of a buffer registered with a `Source_manager`: the n-th buffer added gets ID n.
+ */
+using File_id = uint32_t;
+
+/**
+ * @brief File ID reported for locations that belong to no registered buffer.
+ */
+inline constexpr File_id no_file{std::numeric_limits<File_id>::max()};
+
+/**
+ * @brief Position in any buffer registered with a `Source_manager`, packed into 32 bits.
+ *
+ * Every buffer owns a contiguous range of the manager's location space, so a location is the start of its
+ * buffer's range plus a byte offset, and the file, line and column are recovered with `Source_manager::decode()`.
+ * At 4 bytes it is a twelfth of a `Token_location`, cheap enough to keep for every token or AST node of thousands
+ * of files. The default-constructed location is invalid and belongs to no buffer.
+ */
+class Source_location
+{
+public:
+    constexpr Source_location() noexcept = default;
+
+    /**
+     * @brief Location with the given encoding, e.g. one read back from `raw()`.
+     */
+    [[nodiscard]] static constexpr Source_location from_raw(const uint32_t raw) noexcept
+    {
+        Source_location location;
+
+        location.raw_ = raw;
+
+        return location;
+    }
+
+    /**
+     * @brief The 32-bit encoding.
+     */
+    [[nodiscard]] constexpr uint32_t raw() const noexcept
+    {
+        return raw_;
+    }
+
+    /**
+     * @brief Returns true unless the location is default-constructed.
+     */
+    [[nodiscard]] constexpr bool valid() const noexcept
+    {
+        return raw_ != 0;
+    }
+
+    /**
+     * @brief Location `bytes` further into the same buffer; the caller keeps it within the buffer.
+     */
+    [[nodiscard]] constexpr Source_location advanced(const uint32_t bytes) const noexcept
+    {
+        return from_raw(raw_ + bytes);
+    }
+
+    /**
+     * @brief Locations order by buffer, in registration order, and by offset within a buffer.
+     */
+    friend constexpr auto operator<=>(Source_location, Source_location) noexcept = default;
+
+private:
+    uint32_t raw_{0};
+};
+
+static_assert(sizeof(Source_location) == sizeof(uint32_t));
+
+/**
+ * @brief Assigns every loaded buffer a range of a global 32-bit location space and decodes locations back.
+ *
+ * A buffer of `n` bytes takes `n + 1` locations, so the position right after its last byte (e.g. for an error at
+ * the end of input) is addressable as well. Only line starts are kept per buffer, not the text itself. Adding
+ * buffers is not thread-safe; decoding is, as long as no buffer is added concurrently. Register the tapes of a
+ * `Token_batch` one by one after tokenizing them, or a whole preprocessed unit with
+ * `Translation_unit::locations()`.
+ */
+class Source_manager
+{
+public:
+    /**
+     * @brief A location resolved to its buffer, byte offset, line and column (both 1-based).
+     */
+    struct Decoded
+    {
+        File_id file{no_file};
+
+        std::size_t offset{0};
+
+        std::size_t line{0};
+
+        std::size_t column{0};
+    };
+
+    /**
+     * @brief Register a buffer and reserve its range of locations.
+     * @param name Name reported for the buffer, usually its path.
+     * @param text Normalized contents; only read during the call, to find line starts.
+     *
+     * @throws std::length_error If the buffer does not fit in the remaining location space.
+     */
+    File_id add(std::filesystem::path name, std::string_view text);
+
+    /**
+     * @brief Location of byte `offset` of `file`; offsets past the end are clamped to the end of the buffer.
+     */
+    [[nodiscard]] Source_location location(File_id file, std::size_t offset) const noexcept;
+
+    /**
+     * @brief Buffer a location belongs to, or `no_file`.
+     */
+    [[nodiscard]] File_id file(Source_location location) const noexcept;
+
+    /**
+     * @brief Buffer, offset, line and column of a location; `file` is `no_file` for unknown locations.
+     */
+    [[nodiscard]] Decoded decode(Source_location location) const noexcept;
+
+    /**
+     * @brief Diagnostic reporting `message` at a location.
+     */
+    [[nodiscard]] Diagnostic diagnostic(Source_location location, std::string message) const;
+
+    /**
+     * @brief Name the buffer was registered with.
+     */
+    [[nodiscard]] const std::filesystem::path& name(File_id file) const noexcept;
+
+    /**
+     * @brief Size in bytes of the buffer.
+     */
+    [[nodiscard]] std::size_t size(File_id file) const noexcept;
+
+    /**
+     * @brief Number of registered buffers.
+     */
+    [[nodiscard]] std::size_t files() const noexcept;
+
+private:
+    struct Entry
+    {
+        std::filesystem::path name;
+
+        uint32_t size;
+
+        Line_index lines;
+    };
+
+    /**
+     * @brief First location of every buffer, in increasing order, searched on its own for locality.
+     */
+    std::vector<uint32_t> starts_;
+
+    std::vector<Entry> entries_;
+
+    /**
+     * @brief First unassigned location; 0 is the invalid location.
+     */
+    uint32_t next_{1};
+};
+
+} // namespace parser::idl
+
+#endif // PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_SOURCE_MANAGER_HPP
@@ -0,0 +1,37 @@
+#ifndef PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_SOURCE_SCANNER_HPP
+#define PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_SOURCE_SCANNER_HPP
+
+#include <cstddef>
+#include <string_view>
+
+namespace parser::idl
+{
+/**
+ * @brief Finds the ends of string literals and comments in raw text, the way the lexer would match them.
+ *
+ * Used by passes that look at the text before it is tokenized (region splitting, directive extraction) and must
+ * not mistake the inside of a literal or comment for code.
+ */
+class Source_scanner
+{
+public:
+    /**
+     * @brief End of the string literal opening at `position`, mirroring the longest match: the last quote before
+     * the first character a literal cannot hold. Returns `npos` if the literal is not closed.
+     */
+    [[nodiscard]] static std::size_t string_end(std::string_view text, std::size_t position) noexcept;
+
+    /**
+     * @brief End of the block comment opening at `position`, mirroring the longest match like `string_end()`.
+     */
+    [[nodiscard]] static std::size_t comment_end(std::string_view text, std::size_t position) noexcept;
+
+    /**
+     * @brief End of the line comment opening at `position`: its newline, or the end of the text.
+     */
+    [[nodiscard]] static std::size_t line_comment_end(std::string_view text, std::size_t position) noexcept;
+};
+
+} // namespace parser::idl
+
+#endif // PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_SOURCE_SCANNER_HPP
@@ -0,0 +1,127 @@
+#ifndef PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_STREAM_SOURCE_HPP
+#define PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_STREAM_SOURCE_HPP
+
+#include <cstddef>
+#include <istream>
+#include <optional>
+#include <string>
+
+namespace parser::idl
+{
+/**
+ * @brief Reads input of unbounded size in fixed-size chunks and hands it out as windows of whole lines.
+ *
+ * Each chunk is newline-normalized as it arrives; a '\r' ending a chunk is held back until the next one, so a
+ * "\r\n" split across chunks still becomes a single '\n'. Windows end after the last '\n' read so far, so a token
+ * that cannot span lines never straddles two windows. Text the lexer did not consume (e.g. the start of a block
+ * comment that continues past the window) is handed out again at the start of the next window. The lexer matches
+ * the longest block comment, which runs to the last comment terminator in the input, so a block comment is only
+ * lexed from a window reaching the end of the input (see `rest()`).
+ *
+ * Only the unconsumed tail of the input is buffered: memory stays bounded by the chunk size plus the longest line,
+ * independent of the total input size, until a block comment opens; from there on the rest of the input is held.
+ */
+class Stream_source
+{
+public:
+    /**
+     * @brief Default number of bytes read at once.
+     */
+    static constexpr std::size_t default_chunk_size{64UL * 1024};
+
+    /**
+     * @brief Stream input from a `std::istream`, which must outlive the source.
+     * @param stream     Stream to read; opened in binary mode for files.
+     * @param chunk_size Number of bytes read at once.
+     *
+     * @throws std::invalid_argument If `chunk_size` is zero.
+     */
+    explicit Stream_source(std::istream& stream, std::size_t chunk_size = default_chunk_size);
+
+    /**
+     * @brief Stream input from a file descriptor (e.g. a pipe), which is not closed by the source.
+     * @param descriptor Open descriptor to read.
+     * @param chunk_size Number of bytes read at once.
+     *
+     * @throws std::invalid_argument If `chunk_size` is zero.
+     */
+    explicit Stream_source(int descriptor, std::size_t chunk_size = default_chunk_size);
+
+    /**
+     * @brief Produce the next window to lex.
+     * @param consumed Number of bytes of the previous window the lexer consumed; the rest starts the new window.
+     * @return The window, or `std::nullopt` once all input was consumed.
+     *
+     * The new window always extends past the previous one, so a lexer stopping early still makes progress.
+     *
+     * @throws std::runtime_error If reading the input fails.
+     */
+    [[nodiscard]] std::optional<std::string> window(std::size_t consumed);
+
+    /**
+     * @brief Produce a window reaching the end of the input, reading all of it.
+     * @param consumed Number of bytes of the previous window the lexer consumed; the rest starts the new window.
+     * @return The window, or `std::nullopt` once all input was consumed.
+     *
+     * @throws std::runtime_error If reading the input fails.
+     */
+    [[nodiscard]] std::optional<std::string> rest(std::size_t consumed);
+
+    /**
+     * @brief True once the last window handed out reaches the end of the input.
+     */
+    [[nodiscard]] bool exhausted() const noexcept;
+
+    /**
+     * @brief True if the last window opens a block comment at the given offset.
+     */
+    [[nodiscard]] bool opens_comment(std::size_t offset) const noexcept;
+
+    /**
+     * @brief Number of input bytes currently held by the source.
+     */
+    [[nodiscard]] std::size_t buffered() const noexcept;
+
+private:
+    /**
+     * @brief Read and normalize one chunk onto the end of the buffer, setting `end_` at end of input.
+     */
+    void fill();
+
+    /**
+     * @brief Read up to `size` bytes from the stream or descriptor.
+     */
+    std::size_t read(char* data, std::size_t size);
+
+    std::istream* stream_;
+
+    int descriptor_;
+
+    std::size_t chunk_size_;
+
+    /**
+     * @brief Unconsumed input, starting with the last window handed out.
+     */
+    std::string buffer_;
+
+    /**
+     * @brief Scratch buffer for the chunk being read, kept to reuse its capacity.
+     */
+    std::string chunk_;
+
+    /**
+     * @brief Size of the last window handed out.
+     */
+    std::size_t window_{0};
+
+    /**
+     * @brief A '\r' ended the last chunk and is waiting to be normalized with the next one.
+     */
+    bool carriage_return_{false};
+
+    bool end_{false};
+};
+
+} // namespace parser::idl
+
+#endif // PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_STREAM_SOURCE_HPP
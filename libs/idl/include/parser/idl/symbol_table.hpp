@@ -0,0 +1,117 @@
+#ifndef PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_SYMBOL_TABLE_HPP
+#define PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_SYMBOL_TABLE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "arena.hpp"
+
+namespace parser::idl
+{
+/**
+ * @brief Dense identifier of an interned name: the n-th distinct name interned by a table gets ID n.
+ */
+using Symbol_id = uint32_t;
+
+/**
+ * @brief Symbol ID reported for tokens that were not interned.
+ */
+inline constexpr Symbol_id no_symbol{std::numeric_limits<Symbol_id>::max()};
+
+/**
+ * @brief Names every symbol table interns first, in this order, so their IDs are known at compile time.
+ */
+inline constexpr std::array<std::string_view, 4> well_known_symbols{"TRUE", "FALSE", "Object", "ValueBase"};
+
+/**
+ * @brief Compile-time ID of a well-known name, e.g. `well_known("Object")`; does not compile for any other name.
+ */
+consteval Symbol_id well_known(const std::string_view name)
+{
+    for (std::size_t index{0}; index < well_known_symbols.size(); ++index)
+    {
+        if (well_known_symbols[index] == name)
+        {
+            return static_cast<Symbol_id>(index);
+        }
+    }
+
+    throw "not a well-known symbol";
+}
+
+/**
+ * @brief Maps each distinct identifier to a dense `Symbol_id`.
+ *
+ * Names are copied into an arena the table owns, so IDs and spellings stay valid after the source buffer they
+ * were interned from is gone. Lookup is an open-addressing probe over cached hashes, so comparing two names
+ * interned by the same table reduces to comparing their IDs. Not thread-safe; see `Concurrent_symbol_table` for
+ * a table shared by several readers.
+ */
+class Symbol_table
+{
+public:
+    /**
+     * @brief Construct a table holding the well-known names followed by `seeds`.
+     * @param seeds Additional names to intern up front, in order; duplicates keep their first ID.
+     */
+    explicit Symbol_table(std::span<const std::string_view> seeds = {});
+
+    /**
+     * @brief ID of `name`, interning it if it was not seen before.
+     * @throws std::length_error If the table already holds `no_symbol` names.
+     */
+    Symbol_id intern(std::string_view name);
+
+    /**
+     * @brief ID of `name` if it was interned, without adding it.
+     */
+    [[nodiscard]] std::optional<Symbol_id> find(std::string_view name) const noexcept;
+
+    /**
+     * @brief Spelling of an interned name; `symbol` must be below `size()`.
+     */
+    [[nodiscard]] std::string_view spelling(Symbol_id symbol) const noexcept;
+
+    /**
+     * @brief Number of distinct names interned.
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+private:
+    /**
+     * @brief Index into `slots_` holding `name`, or the empty slot where it belongs.
+     */
+    [[nodiscard]] std::size_t probe(std::string_view name, std::size_t hash) const noexcept;
+
+    /**
+     * @brief Double the slot array and re-insert every name.
+     */
+    void grow();
+
+    /**
+     * @brief Spellings indexed by ID; they point into `arena_`.
+     */
+    std::vector<std::string_view> spellings_;
+
+    /**
+     * @brief Hash of every name, indexed by ID, so probing and growing never rehash strings.
+     */
+    std::vector<std::size_t> hashes_;
+
+    /**
+     * @brief Open-addressing slots holding an ID, or `no_symbol` when empty; the size is a power of two.
+     */
+    std::vector<Symbol_id> slots_;
+
+    Arena arena_;
+};
+
+} // namespace parser::idl
+
+#endif // PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_SYMBOL_TABLE_HPP
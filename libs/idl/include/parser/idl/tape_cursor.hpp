@@ -0,0 +1,72 @@
+#ifndef PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_TAPE_CURSOR_HPP
+#define PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_TAPE_CURSOR_HPP
+
+#include <cstddef>
+#include <optional>
+
+#include "token_tape.hpp"
+#include "tokens.hpp"
+
+namespace parser::idl
+{
+/**
+ * @brief Read position over a `Token_tape`.
+ *
+ * Offers the `peek()`/`next()` interface of `Token_reader` with unbounded lookahead. Since the tape is fully
+ * lexed up front, lexical errors were already reported when it was built, and backtracking is just restoring a
+ * saved `position()`.
+ */
+class Tape_cursor
+{
+public:
+    using Token_t = Token_tape::Token_t;
+
+    /**
+     * @brief Construct a cursor at the start of the tape. The tape must outlive the cursor.
+     */
+    explicit Tape_cursor(const Token_tape& tape) noexcept;
+
+    /**
+     * @brief Look `n` tokens past the next one without consuming it; `std::nullopt` past the end.
+     */
+    [[nodiscard]] std::optional<Token_t> peek(std::size_t n = 0) const noexcept;
+
+    /**
+     * @brief Kind of the token `n` past the next one, if any; cheaper than `peek()` for dispatching.
+     */
+    [[nodiscard]] std::optional<Token_kind> kind(std::size_t n = 0) const noexcept;
+
+    /**
+     * @brief Retrieve the next token and advance; `std::nullopt` at the end.
+     */
+    std::optional<Token_t> next() noexcept;
+
+    /**
+     * @brief Index of the next token on the tape.
+     */
+    [[nodiscard]] std::size_t position() const noexcept;
+
+    /**
+     * @brief Move to the given tape index (clamped to the end), e.g. to backtrack.
+     */
+    void seek(std::size_t position) noexcept;
+
+    /**
+     * @brief Returns true once every token has been consumed.
+     */
+    [[nodiscard]] bool at_end() const noexcept;
+
+    /**
+     * @brief The tape being traversed.
+     */
+    [[nodiscard]] const Token_tape& tape() const noexcept;
+
+private:
+    const Token_tape* tape_;
+
+    std::size_t position_;
+};
+
+} // namespace parser::idl
+
+#endif // PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_TAPE_CURSOR_HPP
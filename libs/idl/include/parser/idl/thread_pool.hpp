@@ -0,0 +1,96 @@
+#ifndef PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_THREAD_POOL_HPP
+#define PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace parser::idl
+{
+/**
+ * @brief Fixed set of worker threads executing batches of indexed tasks with work stealing.
+ *
+ * A batch is dealt round-robin onto per-worker queues in the given order. Each worker drains its own queue from
+ * the front and, once empty, steals from the back of the others, so the tasks listed first (e.g. the largest
+ * inputs) start first and idle workers pick up the remaining tail.
+ */
+class Thread_pool
+{
+public:
+    /**
+     * @brief Task body, called with the task index and the index of the worker running it.
+     */
+    using Task_t = std::function<void(std::size_t task, std::size_t worker)>;
+
+    /**
+     * @brief Start the given number of workers (at least one).
+     */
+    explicit Thread_pool(std::size_t threads = default_threads());
+
+    Thread_pool(const Thread_pool&) = delete;
+
+    Thread_pool& operator=(const Thread_pool&) = delete;
+
+    ~Thread_pool();
+
+    /**
+     * @brief Number of worker threads.
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /**
+     * @brief Run `task` for every index in `order` and wait for all of them.
+     *
+     * Tasks may run concurrently, but no two tasks run on the same worker at once. If tasks throw, the remaining
+     * tasks still run and the first exception is rethrown here. Calls to `run()` must not overlap.
+     */
+    void run(std::span<const std::size_t> order, const Task_t& task);
+
+    /**
+     * @brief Number of hardware threads, or one if unknown.
+     */
+    [[nodiscard]] static std::size_t default_threads() noexcept;
+
+private:
+    struct Queue
+    {
+        std::mutex mutex;
+
+        std::deque<std::size_t> tasks;
+    };
+
+    void work(std::size_t worker);
+
+    bool pop(std::size_t worker, std::size_t& task);
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+
+    std::mutex mutex_;
+
+    std::condition_variable wake_;
+
+    std::condition_variable done_;
+
+    const Task_t* task_{nullptr};
+
+    std::size_t generation_{0};
+
+    std::size_t active_{0};
+
+    bool stop_{false};
+
+    std::exception_ptr error_;
+
+    std::vector<std::jthread> threads_;
+};
+
+} // namespace parser::idl
+
+#endif // PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_THREAD_POOL_HPP
@@ -0,0 +1,114 @@
+#ifndef PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_TOKEN_BATCH_HPP
+#define PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_TOKEN_BATCH_HPP
+
+#include <cstddef>
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "concurrent_symbol_table.hpp"
+#include "diagnostic.hpp"
+#include "reader_metrics.hpp"
+#include "thread_pool.hpp"
+#include "token_reader.hpp"
+#include "token_tape.hpp"
+
+namespace parser::idl
+{
+/**
+ * @brief Tokenizes many files in parallel.
+ *
+ * Files are scheduled largest first on a work-stealing `Thread_pool`. Every worker owns one `Token_reader`
+ * (created on first use from the shared lexer and reused for every file it processes), and results are returned
+ * in input order.
+ */
+class Token_batch
+{
+public:
+    /**
+     * @brief Per-file result: a detached token tape, or the diagnostic that stopped tokenization.
+     */
+    using Result_t = std::expected<Token_tape, Diagnostic>;
+
+    /**
+     * @brief Construct a batch tokenizer.
+     * @param lexer   Lexer used to recognize tokens.
+     * @param threads Number of worker threads.
+     */
+    explicit Token_batch(lexer::core::Lexer lexer, std::size_t threads = Thread_pool::default_threads());
+
+    /**
+     * @brief Construct a batch tokenizer from a compiled lexer shared with other readers or batches.
+     * @param lexer   Shared, immutable lexer used to recognize tokens.
+     * @param threads Number of worker threads.
+     */
+    explicit Token_batch(
+            std::shared_ptr<const lexer::core::Lexer> lexer, std::size_t threads = Thread_pool::default_threads());
+
+    /**
+     * @brief Tokenize every file into a tape.
+     *
+     * @param files Paths of the files to tokenize.
+     * @return One result per file, in the order of `files`.
+     */
+    [[nodiscard]] std::vector<Result_t> tokenize(std::span<const std::filesystem::path> files);
+
+    /**
+     * @brief Intern the identifiers of every file into one table shared by all workers (see `Token_tape::symbol()`).
+     *
+     * The table must outlive the batch or the next `attach_symbols()` / `detach_symbols()`.
+     */
+    void attach_symbols(Concurrent_symbol_table& symbols) noexcept;
+
+    /**
+     * @brief Stop interning identifiers.
+     */
+    void detach_symbols() noexcept;
+
+    /**
+     * @brief Events counted while tokenizing file `index` of the last `tokenize()` call.
+     *
+     * All zero unless built with `PARSER_IDL_METRICS`.
+     */
+    [[nodiscard]] Reader_metrics metrics(std::size_t index) const noexcept;
+
+    /**
+     * @brief Events counted over all files of the last `tokenize()` call.
+     */
+    [[nodiscard]] Reader_metrics metrics() const noexcept;
+
+    /**
+     * @brief Number of worker threads.
+     */
+    [[nodiscard]] std::size_t threads() const noexcept;
+
+    /**
+     * @brief Indices of `files` ordered by decreasing file size; unreadable files go last.
+     */
+    [[nodiscard]] static std::vector<std::size_t> schedule(std::span<const std::filesystem::path> files);
+
+private:
+    /**
+     * @brief The calling worker's reader, created on first use.
+     */
+    Token_reader& reader(std::size_t worker);
+
+    std::shared_ptr<const lexer::core::Lexer> lexer_;
+
+    Thread_pool pool_;
+
+    std::vector<std::unique_ptr<Token_reader>> readers_;
+
+    Concurrent_symbol_table* symbols_{nullptr};
+
+    /**
+     * @brief Per-file metrics of the last batch; empty when metrics are disabled.
+     */
+    std::vector<Reader_metrics> metrics_;
+};
+
+} // namespace parser::idl
+
+#endif // PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_TOKEN_BATCH_HPP
@@ -0,0 +1,194 @@
+#ifndef PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_TOKEN_DOCUMENT_HPP
+#define PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_TOKEN_DOCUMENT_HPP
+
+#include <cstddef>
+#include <expected>
+#include <lexer/tools/tokenizer/tokenizer.hpp>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "line_index.hpp"
+#include "shifted_offsets.hpp"
+#include "tokens.hpp"
+
+namespace parser::idl
+{
+/**
+ * @brief Tokens replaced by an edit of a `Token_document`.
+ *
+ * The `removed` tokens starting at index `first` were replaced by `inserted` freshly lexed tokens. All tokens
+ * after them were reused, with their offsets shifted by the change in text length.
+ */
+struct Token_edit
+{
+    std::size_t first{0};
+
+    std::size_t removed{0};
+
+    std::size_t inserted{0};
+};
+
+/**
+ * @brief Tokenized text that is kept up to date as it is edited, for editor integrations.
+ *
+ * Every token is stored, trivia included, as a kind and a start offset. After an edit, lexing restarts at the
+ * token holding the newline that precedes the edited line, and stops as soon as a token boundary past the edit
+ * coincides with a boundary of the old token stream: lexing from the same offset over the same remaining text
+ * yields the same tokens, so everything after it is reused. The text is re-lexed in windows of whole lines that
+ * grow geometrically, so the work done is proportional to the size of the edit rather than of the text.
+ *
+ * Tokens other than block comments are assumed not to depend on text past the end of their line. A block comment
+ * opened in the re-lexed range is lexed from a window reaching the last comment terminator in the text, and edits
+ * that add, remove or split a comment delimiter can change tokens anywhere, so they re-lex the whole text.
+ *
+ * The text is used as given, without newline normalization, so offsets stay those of the editor's buffer.
+ */
+class Token_document
+{
+public:
+    /**
+     * @brief Alias for the token type produced by the underlying lexer.
+     */
+    using Token_t = lexer::tools::tokenizer::Token<Token_kind>;
+
+    /**
+     * @brief Error type reported for lexical issues.
+     */
+    using Error_t = lexer::tools::tokenizer::Tokenizer::Result_t<Token_kind>::error_type;
+
+    /**
+     * @brief Tokens replaced by a load or an edit, or the lexical error that stopped lexing.
+     */
+    using Edit_result_t = std::expected<Token_edit, Error_t>;
+
+    /**
+     * @brief Construct an empty document.
+     * @param lexer Lexer used to recognize tokens.
+     */
+    explicit Token_document(lexer::core::Lexer lexer);
+
+    /**
+     * @brief Construct a document and tokenize its initial text.
+     * @param lexer Lexer used to recognize tokens.
+     * @param text  Initial text; a lexical error in it is reported by `error()`.
+     */
+    Token_document(lexer::core::Lexer lexer, std::string text);
+
+    /**
+     * @brief Replace the whole text and tokenize it from scratch.
+     */
+    Edit_result_t load(std::string text);
+
+    /**
+     * @brief Replace a byte range of the text and re-lex only what the edit can affect.
+     * @param offset Start of the replaced range.
+     * @param length Length of the replaced range.
+     * @param text   Replacement text.
+     * @return The tokens replaced, or the lexical error that stopped lexing.
+     *
+     * The edit is always applied. On a lexical error tokens end at the error, as reported by `lexed()`, and later
+     * edits re-lex past it.
+     *
+     * @throws std::out_of_range If the range is not within the text.
+     */
+    Edit_result_t replace(std::size_t offset, std::size_t length, std::string_view text);
+
+    /**
+     * @brief Current text.
+     */
+    [[nodiscard]] const std::string& text() const noexcept;
+
+    /**
+     * @brief Number of tokens, trivia included.
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /**
+     * @brief Kind of the token at `index`.
+     */
+    [[nodiscard]] Token_kind kind(std::size_t index) const noexcept;
+
+    /**
+     * @brief Byte offset of the first character of the token at `index`.
+     */
+    [[nodiscard]] std::size_t offset(std::size_t index) const noexcept;
+
+    /**
+     * @brief Length in bytes of the token at `index`.
+     */
+    [[nodiscard]] std::size_t length(std::size_t index) const noexcept;
+
+    /**
+     * @brief Text of the token at `index`.
+     */
+    [[nodiscard]] std::string_view lexeme(std::size_t index) const noexcept;
+
+    /**
+     * @brief The token at `index` in the form returned by `Token_reader`.
+     */
+    [[nodiscard]] Token_t token(std::size_t index) const noexcept;
+
+    /**
+     * @brief Line (1-based) on which the token at `index` starts.
+     */
+    [[nodiscard]] std::size_t line(std::size_t index) const noexcept;
+
+    /**
+     * @brief Column (1-based) at which the token at `index` starts.
+     */
+    [[nodiscard]] std::size_t column(std::size_t index) const noexcept;
+
+    /**
+     * @brief Length of the text prefix covered by tokens: the whole text unless a lexical error stopped lexing.
+     */
+    [[nodiscard]] std::size_t lexed() const noexcept;
+
+    /**
+     * @brief The lexical error at `lexed()`, if any. Its position is an offset in the text.
+     */
+    [[nodiscard]] const std::optional<Error_t>& error() const noexcept;
+
+private:
+    /**
+     * @brief Lex from token `first`, which starts at `start`, and splice the result into the token columns.
+     * @param edit_end Offset in the new text just past the edit; resynchronization is only attempted from there.
+     * @param delta    Change in text length made by the edit.
+     * @param resync   Whether old tokens may be reused; otherwise lexing runs to the end of the text.
+     */
+    Edit_result_t relex(std::size_t first, std::size_t start, std::size_t edit_end, std::ptrdiff_t delta, bool resync);
+
+    /**
+     * @brief Returns true if the edit adds, removes or splits a block comment delimiter.
+     */
+    [[nodiscard]] bool touches_comment(std::size_t offset, std::size_t length, std::string_view text) const;
+
+    /**
+     * @brief Offset just past the first '\n' at or after `offset`, or the end of the text.
+     */
+    [[nodiscard]] std::size_t line_end(std::size_t offset) const noexcept;
+
+    lexer::tools::tokenizer::Tokenizer tokenizer_;
+
+    std::string text_;
+
+    std::vector<Token_kind> kinds_;
+
+    Shifted_offsets offsets_;
+
+    std::size_t lexed_{0};
+
+    /**
+     * @brief Offset of the last comment terminator in the text, kept up to date by edits.
+     */
+    std::size_t closing_{std::string::npos};
+
+    std::optional<Error_t> error_;
+
+    Line_index lines_;
+};
+
+} // namespace parser::idl
+
+#endif // PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_TOKEN_DOCUMENT_HPP
@@ -2,17 +2,41 @@
 #define PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_TOKEN_LOCATION_HPP
 
 #include <cstddef>
+#include <cstdint>
 #include <string_view>
 
+#include "line_index.hpp"
 #include "tokens.hpp"
+#include "utf8.hpp"
 
 namespace parser::idl
 {
+/**
+ * @brief Selects how line and column numbers are tracked.
+ */
+enum class Location_mode : uint8_t
+{
+    /**
+     * Line and column are advanced for every token, including skipped trivia.
+     */
+    Eager,
+
+    /**
+     * Only the byte offset is advanced; line and column are resolved on demand through a `Line_index`.
+     */
+    Lazy,
+};
+
 /**
  * @brief Tracks the current position within the input source.
  *
  * Maintains line, column, and byte offset counters that are advanced as tokens are consumed.
  * Used to provide accurate diagnostic information and source mapping during parsing.
+ *
+ * When a `Line_index` is attached only the offset is advanced, and line and column are looked up from it.
+ *
+ * Columns count bytes by default. Counting code points or UTF-16 units only measures literals and comments, the
+ * only tokens that can hold non-ASCII text, so other tokens cost the same in every unit.
  */
 class Token_location
 {
@@ -37,11 +61,28 @@ public:
      */
     [[nodiscard]] std::size_t offset() const noexcept;
 
+    /**
+     * @brief The unit columns are counted in.
+     */
+    [[nodiscard]] Column_unit column_unit() const noexcept;
+
+    /**
+     * @brief Count columns in `unit` from now on; set it before advancing past the first token.
+     */
+    void set_column_unit(Column_unit unit) noexcept;
+
     /**
      * @brief Reset the reading position to the beginning of the current input.
      */
     void reset() noexcept;
 
+    /**
+     * @brief Resolve line and column through the given index instead of counting them.
+     *
+     * Passing `nullptr` restores eager line and column tracking. The index must outlive this location.
+     */
+    void attach(const Line_index* index) noexcept;
+
     /**
      * @brief Advance the position based on a token.
      *
@@ -59,6 +100,16 @@ private:
     std::size_t column_;
 
     std::size_t offset_;
+
+    const Line_index* index_;
+
+    Column_unit unit_{Column_unit::Bytes};
+
+    /**
+     * @brief Start of the input the advanced lexemes belong to; tracked only to measure columns through `index_`
+     * in a unit other than bytes.
+     */
+    const char* input_{nullptr};
 };
 
 } // namespace parser::idl
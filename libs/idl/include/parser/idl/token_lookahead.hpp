@@ -1,19 +1,23 @@
 #ifndef PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_TOKEN_LOOKAHEAD_HPP
 #define PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_TOKEN_LOOKAHEAD_HPP
 
+#include <array>
+#include <cstddef>
 #include <lexer/tools/tokenizer/token.hpp>
 #include <optional>
 
+#include "symbol_table.hpp"
 #include "token_location.hpp"
 #include "tokens.hpp"
 
 namespace parser::idl
 {
 /**
- * @brief Holds the currently buffered (lookahead) token and its source location.
+ * @brief Holds the currently buffered (lookahead) tokens and their source locations.
  *
- * Used by the parser to support one-token lookahead behavior. Stores both the token
- * returned from the lexer and its associated location in the input.
+ * Used by the parser to support multi-token lookahead. Tokens returned from the lexer are kept in a
+ * fixed-capacity ring buffer, each slot storing the token together with the location right after it.
+ * Trivia never enters the ring; it only advances the running location (see `skip()`).
  */
 class Token_lookahead
 {
@@ -26,43 +30,119 @@ public:
      */
     using Token_t = lexer::tools::tokenizer::Token<Token_kind>;
 
+    /**
+     * @brief Maximum number of tokens that can be buffered at once.
+     */
+    static constexpr std::size_t capacity{4};
+
     /**
      * @brief Constructs an empty lookahead state.
      */
     Token_lookahead() = default;
 
     /**
-     * @brief Access the current lookahead token, if any.
+     * @brief Access the front lookahead token, if any.
      */
     [[nodiscard]] const std::optional<Token_t>& token() const noexcept;
 
+    /**
+     * @brief Access the buffered token `n` positions after the front, or an empty optional if not buffered.
+     */
+    [[nodiscard]] const std::optional<Token_t>& token(std::size_t n) const noexcept;
+
     /**
      * @brief Access the location associated with the current token.
+     *
+     * This is the location after the front token when one is buffered, and the location after the last
+     * token read from the lexer (including trivia) otherwise.
      */
     [[nodiscard]] const Token_location& location() const noexcept;
 
     /**
-     * @brief Consume and clear the buffered token.
+     * @brief Access the location after the buffered token `n` positions after the front.
      *
-     * Returns the currently stored token (if any) and resets the internal optional to an empty state.
+     * Falls back to `location()` when fewer than `n + 1` tokens are buffered.
+     */
+    [[nodiscard]] const Token_location& location(std::size_t n) const noexcept;
+
+    /**
+     * @brief Symbol ID of the buffered token `n` positions after the front, or `no_symbol` if it has none.
+     */
+    [[nodiscard]] Symbol_id symbol(std::size_t n) const noexcept;
+
+    /**
+     * @brief Number of buffered tokens.
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /**
+     * @brief Consume and clear the front token.
+     *
+     * Returns the front token (if any) and removes it from the buffer.
      */
     std::optional<Token_t> consume() noexcept;
 
     /**
-     * @brief Reset the reading position to the beginning of the current input and clear token.
+     * @brief Drop the front token without returning it; does nothing if none is buffered.
+     */
+    void pop() noexcept;
+
+    /**
+     * @brief Reset the reading position to the beginning of the current input and clear all tokens.
      */
     void reset() noexcept;
 
     /**
-     * @brief Update the lookahead token and advance the source location.
+     * @brief Resolve line and column of the tracked locations through the given index (see `Token_location`).
+     */
+    void attach(const Line_index* index) noexcept;
+
+    /**
+     * @brief Count columns of the tracked locations in `unit` (see `Token_location`).
+     */
+    void set_column_unit(Column_unit unit) noexcept;
+
+    /**
+     * @brief Append a token read from the lexer and advance the source location.
      *
-     * Called when a new token is read from the lexer. It updates both the stored token
-     * and the internal source position tracker.
+     * Must not be called when `size() == capacity`.
+     */
+    void advance(Token_kind kind, std::string_view lexeme, Symbol_id symbol = no_symbol) noexcept;
+
+    /**
+     * @brief Advance the source location past a token that is not buffered (trivia).
      */
-    void advance(Token_kind kind, std::string_view lexeme) noexcept;
+    void skip(Token_kind kind, std::string_view lexeme) noexcept;
+
+    /**
+     * @brief Call `function` with a mutable reference to every buffered token, front first.
+     */
+    template <typename Function>
+    void for_each(Function&& function)
+    {
+        for (std::size_t n{0}; n < size_; ++n)
+        {
+            function(*slots_[(head_ + n) % capacity].token);
+        }
+    }
 
 private:
-    std::optional<Token_t> token_;
+    struct Slot
+    {
+        std::optional<Token_t> token;
+
+        Token_location location;
+
+        Symbol_id symbol{no_symbol};
+    };
+
+    [[nodiscard]] const Slot& slot(std::size_t n) const noexcept;
+
+    std::array<Slot, capacity> slots_;
+
+    std::size_t head_{0};
+
+    std::size_t size_{0};
 
     Token_location location_;
 };
@@ -0,0 +1,117 @@
+#ifndef PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_TOKEN_RANGE_HPP
+#define PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_TOKEN_RANGE_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <ranges>
+
+#include "token_reader.hpp"
+
+namespace parser::idl
+{
+/**
+ * @brief Lazy input view over the tokens a `Token_reader` returns, for composing with `std::views`.
+ *
+ * Tokens are pulled from the reader one at a time as the view is iterated, with the reader's trivia policy
+ * applied, and are read in place through `Token_reader::current()`. Iteration consumes the reader, so, like
+ * `std::ranges::istream_view`, the view is single-pass and its iterators share the reader's position. It ends at
+ * the end of input or at the first lexical error; `error()` tells the two apart. The view only refers to the
+ * reader, which must outlive it, so copies of it are cheap and all see the same stream and the same error.
+ *
+ * A `std::generator` would express the same, but the view avoids the coroutine frame and compiles with standard
+ * libraries that lack `<generator>`.
+ */
+class Token_range : public std::ranges::view_interface<Token_range>
+{
+public:
+    using Token_t = Token_reader::Token_t;
+
+    using Error_t = Token_reader::Error_t;
+
+    /**
+     * @brief Input iterator yielding the reader's current token.
+     *
+     * Defined inline so that a range-`for` over the view compiles to the same loop as calling `current()` and
+     * `accept()` by hand.
+     */
+    class Iterator
+    {
+    public:
+        using value_type = Token_t;
+
+        using difference_type = std::ptrdiff_t;
+
+        using iterator_concept = std::input_iterator_tag;
+
+        Iterator() noexcept = default;
+
+        explicit Iterator(Token_reader& reader) noexcept : reader_{&reader}
+        {}
+
+        /**
+         * @brief The reader's current token, valid until the iterator is incremented.
+         */
+        [[nodiscard]] const Token_t& operator*() const
+        {
+            return *reader_->current();
+        }
+
+        [[nodiscard]] const Token_t* operator->() const
+        {
+            return reader_->current();
+        }
+
+        /**
+         * @brief Consume the current token.
+         */
+        Iterator& operator++()
+        {
+            (void) reader_->accept(reader_->current()->kind());
+
+            return *this;
+        }
+
+        void operator++(int)
+        {
+            ++*this;
+        }
+
+        [[nodiscard]] friend bool operator==(const Iterator& iterator, std::default_sentinel_t)
+        {
+            return iterator.reader_->current() == nullptr;
+        }
+
+    private:
+        Token_reader* reader_{nullptr};
+    };
+
+    /**
+     * @brief Construct a view over the remaining tokens of `reader`.
+     */
+    explicit Token_range(Token_reader& reader) noexcept;
+
+    /**
+     * @brief Iterator at the reader's next token.
+     */
+    [[nodiscard]] Iterator begin() const noexcept;
+
+    [[nodiscard]] static std::default_sentinel_t end() noexcept;
+
+    /**
+     * @brief The lexical error that ended iteration, or `std::nullopt` if it reached the end of input.
+     *
+     * Only meaningful once the view has been iterated to its end.
+     */
+    [[nodiscard]] std::optional<Error_t> error() const;
+
+private:
+    Token_reader* reader_;
+};
+
+} // namespace parser::idl
+
+template <>
+inline constexpr bool std::ranges::enable_borrowed_range<parser::idl::Token_range> = true;
+
+#endif // PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_TOKEN_RANGE_HPP
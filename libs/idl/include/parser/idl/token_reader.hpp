@@ -1,11 +1,27 @@
 #ifndef PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_TOKEN_READER_HPP
 #define PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_TOKEN_READER_HPP
 
+#include <expected>
 #include <filesystem>
 #include <lexer/tools/tokenizer/tokenizer.hpp>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
 
+#include "comment_table.hpp"
+#include "concurrent_symbol_table.hpp"
+#include "line_index.hpp"
+#include "reader_metrics.hpp"
+#include "stream_source.hpp"
+#include "symbol_table.hpp"
+#include "token_location.hpp"
 #include "token_lookahead.hpp"
+#include "token_tape.hpp"
 #include "tokens.hpp"
+#include "trivia_policy.hpp"
 
 namespace parser::idl
 {
@@ -20,40 +36,153 @@ public:
      */
     using Result_t = lexer::tools::tokenizer::Tokenizer::Result_t<Token_kind>;
 
+    /**
+     * @brief Alias for the token type produced by the underlying lexer.
+     */
+    using Token_t = Token_lookahead::Token_t;
+
+    /**
+     * @brief Error type reported for lexical issues.
+     */
+    using Error_t = Result_t::error_type;
+
+    /**
+     * @brief Result of lexing a whole input into a `Token_tape`.
+     */
+    using Tape_result_t = std::expected<Token_tape, Error_t>;
+
+    /**
+     * @brief Opaque position in the token stream returned by `mark()`.
+     */
+    class Checkpoint
+    {
+    private:
+        friend class Token_reader;
+
+        Checkpoint(std::size_t position, std::size_t generation) noexcept
+            : position_{position}, generation_{generation}
+        {}
+
+        std::size_t position_;
+
+        /**
+         * @brief Input generation the checkpoint was taken in; see `Token_reader::generation_`.
+         */
+        std::size_t generation_;
+    };
+
     /**
      * @brief Construct a token stream from a lexer.
      * @param lexer Lexer used to recognize tokens.
+     * @param mode  How line and column numbers are tracked.
      */
-    explicit Token_reader(lexer::core::Lexer lexer);
+    explicit Token_reader(lexer::core::Lexer lexer, Location_mode mode = Location_mode::Eager);
+
+    /**
+     * @brief Construct a token stream from a compiled lexer shared with other readers.
+     * @param lexer Shared, immutable lexer used to recognize tokens.
+     * @param mode  How line and column numbers are tracked.
+     *
+     * Lets any number of readers, on any number of threads, be created from one compiled lexer without running
+     * the `Builder` again. The tokenizer still keeps its own copy of the lexer tables, taken from the shared
+     * instance, because `lexer::tools::tokenizer::Tokenizer` owns its lexer by value.
+     */
+    explicit Token_reader(
+            const std::shared_ptr<const lexer::core::Lexer>& lexer, Location_mode mode = Location_mode::Eager);
 
     /**
      * @brief Construct a token stream from a lexer and an input string held in memory.
      * @param lexer Lexer used to recognize tokens.
      * @param input Input text to tokenize
+     * @param mode  How line and column numbers are tracked.
      */
-    explicit Token_reader(lexer::core::Lexer lexer, const std::string& input);
+    explicit Token_reader(
+            lexer::core::Lexer lexer, const std::string& input, Location_mode mode = Location_mode::Eager);
+
+    /**
+     * @brief Construct a token stream that adopts an input string; see `load(std::string&&)`.
+     */
+    explicit Token_reader(lexer::core::Lexer lexer, std::string&& input, Location_mode mode = Location_mode::Eager);
+
+    /**
+     * @brief Construct a token stream from text in a caller-owned buffer; see `load(std::string_view)`.
+     */
+    explicit Token_reader(
+            lexer::core::Lexer lexer, std::string_view input, Location_mode mode = Location_mode::Eager);
 
     /**
      * @brief Construct a token stream by reading the contents of a file.
      * @param lexer Lexer used to recognize tokens.
      * @param file Path to the file whose contents will be tokenized.
+     * @param mode How line and column numbers are tracked.
+     *
+     * Regular files are memory-mapped and normalized straight from the mapping into the tokenizer's buffer, so the
+     * contents are copied exactly once. Other files (pipes, devices) are read through the private read() helper.
+     */
+    explicit Token_reader(
+            lexer::core::Lexer lexer, const std::filesystem::path& file, Location_mode mode = Location_mode::Eager);
+
+    /**
+     * @brief Construct a token stream that reads its input incrementally from a stream source.
+     * @param lexer  Lexer used to recognize tokens.
+     * @param source Source of the input, e.g. `Stream_source{std::cin}`.
+     * @param mode   How line and column numbers are tracked.
      *
-     * The file is read in binary mode into an internal std::string using the private read() helper.
+     * See `load(Stream_source)`.
      */
-    explicit Token_reader(lexer::core::Lexer lexer, const std::filesystem::path& file);
+    explicit Token_reader(lexer::core::Lexer lexer, Stream_source source, Location_mode mode = Location_mode::Eager);
 
     /**
      * @brief Replace the current input and reset tokenization state.
+     *
+     * The input is copied while its newlines are normalized.
      */
     void load(const std::string& input);
 
+    /**
+     * @brief Replace the current input with a string the caller gives up.
+     *
+     * The buffer is moved into the tokenizer: input without '\r' is never copied, and any other input is
+     * normalized in place.
+     */
+    void load(std::string&& input);
+
+    /**
+     * @brief Replace the current input with text from a caller-owned buffer, such as a network payload or an
+     * arena string.
+     *
+     * The text is read only during this call, so the buffer may be released or reused as soon as it returns. It is
+     * copied exactly once, fused with newline normalization, because the tokenizer owns its input by value; no
+     * intermediate `std::string` is built.
+     */
+    void load(std::string_view input);
+
+    /**
+     * @brief Same as `load(std::string_view)` for a character span.
+     */
+    void load(std::span<const char> input);
+
     /**
      * @brief Load new input from a file path.
      */
     void load(const std::filesystem::path& file);
 
+    /**
+     * @brief Tokenize input read incrementally from a stream source, such as a pipe carrying generated IDL.
+     *
+     * Input is lexed one window of whole lines at a time and released once lexed, so memory stays bounded by the
+     * source's chunk size plus the longest line, up to the first block comment (see `Stream_source`). Tokens still
+     * buffered for lookahead or a checkpoint are kept valid across windows; any other lexeme returned by `next()`
+     * stays valid only until the following call to `peek()` or `next()`. Locations are tracked eagerly in both
+     * modes and `lines()` is `nullptr`, since no index of the whole input exists. Lexical error positions are
+     * offsets in the whole input.
+     */
+    void load(Stream_source source);
+
     /**
      * @brief Reset the reading position to the beginning of the current input.
+     *
+     * Streamed input cannot be read twice: resetting a streaming reader discards the rest of the stream.
      */
     void reset() noexcept;
 
@@ -65,6 +194,17 @@ public:
      */
     [[nodiscard]] Result_t peek();
 
+    /**
+     * @brief Look `n` tokens past the next one without consuming anything.
+     *
+     * `peek(0)` is equivalent to `peek()`. Tokens are read from the lexer at most once: they stay buffered in
+     * the lookahead ring until consumed by `next()`, with trivia filtered out before it enters the ring.
+     * Returns `std::nullopt` if the input ends before the requested token.
+     *
+     * @throws std::out_of_range If `n` is not below `Token_lookahead::capacity`.
+     */
+    [[nodiscard]] Result_t peek(std::size_t n);
+
     /**
      * @brief Retrieve the next token from the stream.
      *
@@ -73,16 +213,228 @@ public:
      */
     [[nodiscard]] Result_t next();
 
+    /**
+     * @brief The next token without consuming it, or `nullptr` at end of input or on a lexical error.
+     *
+     * The fast path of `peek()` for LL(1) parsers: it returns a pointer to the buffered token instead of wrapping
+     * a copy in a `Result_t`. Call `peek()` after a `nullptr` to tell the end of input from an error. The pointer
+     * is valid until the next call that consumes, lexes or rewinds.
+     */
+    [[nodiscard]] const Token_t* current();
+
+    /**
+     * @brief Returns true if the next token has the given kind; false at end of input or on a lexical error.
+     */
+    [[nodiscard]] bool check(Token_kind kind);
+
+    /**
+     * @brief Consume the next token if it has the given kind.
+     */
+    bool accept(Token_kind kind);
+
+    /**
+     * @brief Consume and return the next token if it has the given kind.
+     *
+     * Otherwise nothing is consumed and `std::nullopt` is returned; `peek()` then reports what was found instead,
+     * so the full result is only built on the error path.
+     */
+    [[nodiscard]] std::optional<Token_t> expect(Token_kind kind);
+
+    /**
+     * @brief Remember the current position for speculative parsing.
+     *
+     * While at least one checkpoint is outstanding, tokens consumed by `next()` are retained together with their
+     * locations, so `rewind()` can replay them without re-lexing. Checkpoints nest: every `mark()` must be
+     * balanced by exactly one `rewind()` or `release()`, innermost first.
+     * `load()`, `reset()` and `tape()` drop all outstanding checkpoints; rewinding to or releasing one of them
+     * afterwards does nothing.
+     */
+    [[nodiscard]] Checkpoint mark();
+
+    /**
+     * @brief Return to a checkpoint in O(1) and release it.
+     *
+     * Tokens consumed since the checkpoint are returned again by `peek()` and `next()`, in order and with their
+     * original locations. Until replayed they count as buffered, like peeked tokens, for `location()`.
+     */
+    void rewind(const Checkpoint& checkpoint) noexcept;
+
+    /**
+     * @brief Release a checkpoint without moving, committing to everything consumed since.
+     */
+    void release(const Checkpoint& checkpoint) noexcept;
+
+    /**
+     * @brief Lex the whole current input in one pass into a columnar token tape.
+     *
+     * Trivia is filtered while lexing and no per-token location work is done. The tape refers to this reader's
+     * input buffer, so it stays valid until the next `load()` or the reader's destruction. The reader is rewound
+     * to the beginning of the input afterwards.
+     *
+     * @return The tape on success, or the first lexical error.
+     * @throws std::length_error If the input is too large for the tape's 32-bit offsets.
+     * @throws std::logic_error If the input is streamed (see `load(Stream_source)`).
+     */
+    [[nodiscard]] Tape_result_t tape();
+
     /**
      * @brief Access the location associated with the current token.
+     *
+     * In `Location_mode::Lazy` line and column are resolved when queried, so prefer reading them only when needed.
      */
     [[nodiscard]] const Token_location& location() const noexcept;
 
+    /**
+     * @brief Access the location after the token returned by `peek(n)`.
+     */
+    [[nodiscard]] const Token_location& location(std::size_t n) const noexcept;
+
+    /**
+     * @brief Line starts of the current input in `Location_mode::Lazy`, `nullptr` otherwise.
+     */
+    [[nodiscard]] const Line_index* lines() const noexcept;
+
+    /**
+     * @brief Count the columns reported by `location()` in `unit`; byte offsets are unaffected.
+     *
+     * Columns count bytes by default. Set the unit before reading: it applies to the positions of tokens lexed
+     * afterwards. Columns of `lines()` and of tapes stay in bytes; see `Line_index::column(offset, input, unit)`.
+     */
+    void set_column_unit(Column_unit unit) noexcept;
+
+    /**
+     * @brief The unit columns are counted in.
+     */
+    [[nodiscard]] Column_unit column_unit() const noexcept;
+
+    /**
+     * @brief Choose which tokens are filtered out as trivia and whether filtered comments are recorded.
+     *
+     * The default, `keep_comments`, drops whitespace and newlines only. Applies to tokens lexed afterwards, so set
+     * it before reading.
+     */
+    void set_trivia(const Trivia_policy& policy) noexcept;
+
+    /**
+     * @brief The current trivia policy.
+     */
+    [[nodiscard]] const Trivia_policy& trivia() const noexcept;
+
+    /**
+     * @brief Comments filtered out so far under a policy that records them (see `collect_comments`).
+     *
+     * Keys are the indices of the tokens returned by `next()`, counted from the start of the input. Cleared by
+     * `load()`, `reset()` and `tape()`; tapes never record comments.
+     */
+    [[nodiscard]] const Comment_table& comments() const noexcept;
+
+    /**
+     * @brief Intern every identifier into `symbols` as it is lexed.
+     *
+     * The table must outlive the reader or the next `attach_symbols()` / `detach_symbols()`. Attaching applies to
+     * tokens lexed afterwards; tokens already buffered by `peek()` keep `no_symbol`.
+     */
+    void attach_symbols(Symbol_table& symbols) noexcept;
+
+    /**
+     * @brief Intern every identifier into a table shared with other readers, possibly on other threads.
+     */
+    void attach_symbols(Concurrent_symbol_table& symbols) noexcept;
+
+    /**
+     * @brief Stop interning identifiers.
+     */
+    void detach_symbols() noexcept;
+
+    /**
+     * @brief Symbol ID of the token returned by `peek(n)`.
+     *
+     * `no_symbol` unless that token is an identifier lexed while a symbol table was attached. Identifiers in a
+     * `tape()` get the same IDs, through `Token_tape::symbol()`.
+     */
+    [[nodiscard]] Symbol_id symbol(std::size_t n = 0) const noexcept;
+
+    /**
+     * @brief Events counted since construction or the last `reset_metrics()`; all zero unless built with
+     * `PARSER_IDL_METRICS`.
+     *
+     * Reset before each `load()` to get per-file figures. Normalization of streamed input is not counted.
+     */
+    [[nodiscard]] Reader_metrics metrics() const noexcept;
+
+    /**
+     * @brief Zero the counters reported by `metrics()`.
+     */
+    void reset_metrics() noexcept;
+
 private:
     /**
-     * @brief Returns true if the given token kind should be discarded by the parser.
+     * @brief Hand normalized input to the tokenizer, indexing its lines first in lazy location mode.
+     */
+    void install(std::string input);
+
+    /**
+     * @brief Read the next token, moving on to the next window of streamed input when the current one is used up.
+     *
+     * A token starting a block comment is not returned until the window reaches the end of the input, since the
+     * comment runs to the last terminator in it; it is lexed again from a window holding the rest of the input.
+     */
+    [[nodiscard]] Result_t lex();
+
+    /**
+     * @brief Buffer tokens until `depth` past the lookahead front is available.
+     *
+     * @return `std::nullopt` once buffered, otherwise the end of input or lexical error that stopped it.
+     */
+    [[nodiscard]] std::optional<Result_t> fill(std::size_t depth);
+
+    /**
+     * @brief Consume the next token, which must be available, without returning it.
+     */
+    void consume();
+
+    /**
+     * @brief Call the tokenizer once, timing the call when metrics are enabled.
+     */
+    [[nodiscard]] Result_t tokenize();
+
+    /**
+     * @brief Copy the lexemes of all buffered and retained tokens out of the current window.
      */
-    static bool skip_token(Token_kind kind) noexcept;
+    void pin();
+
+    /**
+     * @brief Number of consumed tokens waiting to be returned again after a `rewind()`.
+     */
+    [[nodiscard]] std::size_t replaying() const noexcept;
+
+    /**
+     * @brief Drop retained tokens once no checkpoint refers to them and all of them were replayed.
+     */
+    void trim() noexcept;
+
+    /**
+     * @brief Forget retained tokens and invalidate all outstanding checkpoints.
+     */
+    void drop_checkpoints() noexcept;
+
+    /**
+     * @brief Kind to report for a token: identifiers spelling a keyword become that keyword.
+     *
+     * Lets lexers built with `Keyword_mode::Perfect_hash` omit keyword rules; for lexers that have them this never
+     * changes the kind, since keyword rules take priority over `Identifier`.
+     */
+    static Token_kind classify(const Token_t& token) noexcept;
+
+    /**
+     * @brief Symbol ID of a token through the attached table: interned for identifiers, `no_symbol` otherwise.
+     */
+    [[nodiscard]] Symbol_id intern(Token_kind kind, std::string_view lexeme);
+
+    /**
+     * @brief Returns true if the given token kind is trivia under the current policy.
+     */
+    [[nodiscard]] bool skip_token(Token_kind kind) const noexcept;
 
     /**
      * @brief Normalize newline sequences in a string.
@@ -93,20 +445,41 @@ private:
      * @param input Input string to normalize.
      * @return Normalized string with unified newlines.
      */
-    static std::string normalize(const std::string& input);
+    std::string normalize(const std::string& input);
+
+    /**
+     * @brief Normalize newline sequences while copying from a borrowed buffer.
+     *
+     * Produces the same result as normalize(const std::string&), but reads from any contiguous character range
+     * (e.g. a memory-mapped file). Input without '\r' is copied in a single block.
+     *
+     * @param input Input text to normalize.
+     * @return Normalized copy of the input with unified newlines.
+     */
+    std::string normalize(std::string_view input);
+
+    /**
+     * @brief Normalize newline sequences in a string the caller gives up.
+     *
+     * The buffer is adopted: it is returned untouched when it contains no '\r', and compacted in place otherwise.
+     *
+     * @param input Input string to normalize.
+     * @return The same buffer with unified newlines.
+     */
+    std::string normalize(std::string&& input) noexcept;
 
     /**
      * @brief Read and normalize a file.
      *
      * Reads the entire file contents and normalizes all newline sequences ("\r\n", "\r")
-     * to a single '\n' form. The file is read in binary mode.
+     * to a single '\n' form. Regular files are memory-mapped; anything else is read in binary mode.
      *
      * @param file Path to the file to read.
      * @return Normalized file contents as a std::string.
      *
      * @throws std::runtime_error If the file cannot be opened.
      */
-    static std::string normalize(const std::filesystem::path& file);
+    std::string normalize(const std::filesystem::path& file);
 
     /**
      * @brief Read the entire file contents into a string.
@@ -123,6 +496,80 @@ private:
     lexer::tools::tokenizer::Tokenizer tokenizer_;
 
     Token_lookahead lookahead_;
+
+    /**
+     * @brief Line starts of the current input; only allocated in lazy location mode.
+     *
+     * Held by pointer so the address attached to the lookahead location survives moves of the reader.
+     */
+    std::unique_ptr<Line_index> line_index_;
+
+    /**
+     * @brief A token consumed while a checkpoint was outstanding, with the location right after it.
+     */
+    struct Retained
+    {
+        Token_t token;
+
+        Token_location location;
+
+        Symbol_id symbol;
+    };
+
+    std::vector<Retained> history_;
+
+    /**
+     * @brief Streamed input; empty when the whole input is held by the tokenizer.
+     */
+    std::optional<Stream_source> stream_;
+
+    /**
+     * @brief Bytes of the current window consumed by the tokenizer.
+     */
+    std::size_t consumed_{0};
+
+    /**
+     * @brief Offset in the streamed input at which the current window starts.
+     */
+    std::size_t window_start_{0};
+
+    /**
+     * @brief Storage for lexemes of tokens that outlive the window they were lexed from.
+     */
+    std::vector<char> pinned_;
+
+    Trivia_policy trivia_{keep_comments};
+
+    Comment_table comments_;
+
+    /**
+     * @brief Number of non-trivia tokens lexed from the current input; the key of the next recorded comment.
+     */
+    std::size_t lexed_{0};
+
+    /**
+     * @brief Table identifiers are interned into, if any; at most one of the two is set.
+     */
+    Symbol_table* symbols_{nullptr};
+
+    Concurrent_symbol_table* shared_symbols_{nullptr};
+
+    /**
+     * @brief Index into `history_` of the next token to replay; equal to its size when not replaying.
+     */
+    std::size_t replay_{0};
+
+    /**
+     * @brief Number of outstanding checkpoints.
+     */
+    std::size_t marks_{0};
+
+    /**
+     * @brief Incremented whenever checkpoints are dropped, so stale ones can be recognized and ignored.
+     */
+    std::size_t generation_{0};
+
+    [[no_unique_address]] Metrics_recorder<Reader_metrics::enabled> metrics_;
 };
 
 } // namespace parser::idl
@@ -0,0 +1,144 @@
+#ifndef PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_TOKEN_TAPE_HPP
+#define PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_TOKEN_TAPE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <lexer/tools/tokenizer/token.hpp>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "line_index.hpp"
+#include "symbol_table.hpp"
+#include "tokens.hpp"
+
+namespace parser::idl
+{
+/**
+ * @brief Pre-tokenized input stored as parallel columns.
+ *
+ * Holds one entry per non-trivia token: its kind (one byte), its byte offset and its length (four bytes each),
+ * for 9 bytes per token instead of a full token object plus location. Lexemes are views into the source buffer
+ * the tape was built from, which must outlive the tape unless it is `detach()`ed. Line and column numbers are
+ * resolved through a `Line_index` built alongside the tape. Tapes built by a reader with a symbol table attached
+ * carry a fourth column with the symbol ID of every token.
+ *
+ * Tapes are produced by `Token_reader::tape()` and traversed with a `Tape_cursor`.
+ */
+class Token_tape
+{
+public:
+    /**
+     * @brief Alias for the token type produced by the underlying lexer.
+     */
+    using Token_t = lexer::tools::tokenizer::Token<Token_kind>;
+
+    /**
+     * @brief Constructs an empty tape.
+     */
+    Token_tape() = default;
+
+    /**
+     * @brief Number of tokens on the tape.
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /**
+     * @brief Returns true if the tape holds no tokens.
+     */
+    [[nodiscard]] bool empty() const noexcept;
+
+    /**
+     * @brief Kind of the token at `index`.
+     */
+    [[nodiscard]] Token_kind kind(std::size_t index) const noexcept;
+
+    /**
+     * @brief Byte offset of the first character of the token at `index`.
+     */
+    [[nodiscard]] std::size_t offset(std::size_t index) const noexcept;
+
+    /**
+     * @brief Length in bytes of the token at `index`.
+     */
+    [[nodiscard]] std::size_t length(std::size_t index) const noexcept;
+
+    /**
+     * @brief Text of the token at `index`.
+     */
+    [[nodiscard]] std::string_view lexeme(std::size_t index) const noexcept;
+
+    /**
+     * @brief The token at `index` in the form returned by `Token_reader`.
+     */
+    [[nodiscard]] Token_t token(std::size_t index) const noexcept;
+
+    /**
+     * @brief Symbol ID of the token at `index`: set for identifiers if the tape was built with a symbol table
+     * attached to the reader, `no_symbol` otherwise.
+     */
+    [[nodiscard]] Symbol_id symbol(std::size_t index) const noexcept;
+
+    /**
+     * @brief Line (1-based) on which the token at `index` starts.
+     */
+    [[nodiscard]] std::size_t line(std::size_t index) const noexcept;
+
+    /**
+     * @brief Column (1-based) at which the token at `index` starts.
+     */
+    [[nodiscard]] std::size_t column(std::size_t index) const noexcept;
+
+    /**
+     * @brief Line starts of the source, for resolving offsets that are not token starts.
+     */
+    [[nodiscard]] const Line_index& lines() const noexcept;
+
+    /**
+     * @brief The complete source text the tape refers to.
+     */
+    [[nodiscard]] std::string_view source() const noexcept;
+
+    /**
+     * @brief Heap memory held by the token columns, in bytes.
+     */
+    [[nodiscard]] std::size_t bytes() const noexcept;
+
+    /**
+     * @brief Copy the source into storage shared by the tape and its copies.
+     *
+     * Afterwards the tape no longer depends on the reader it was built from, at the cost of one copy of the input.
+     */
+    void detach();
+
+private:
+    friend class Token_reader;
+
+    void push(Token_kind kind, std::size_t offset, std::size_t length);
+
+    void push(Token_kind kind, std::size_t offset, std::size_t length, Symbol_id symbol);
+
+    void finish(std::string_view source);
+
+    std::vector<Token_kind> kinds_;
+
+    std::vector<uint32_t> offsets_;
+
+    std::vector<uint32_t> lengths_;
+
+    /**
+     * @brief Empty unless the tape was built with a symbol table; one entry per token otherwise.
+     */
+    std::vector<Symbol_id> symbols_;
+
+    std::string_view source_;
+
+    std::shared_ptr<const std::string> storage_;
+
+    Line_index lines_;
+};
+
+} // namespace parser::idl
+
+#endif // PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_TOKEN_TAPE_HPP
@@ -51,6 +51,8 @@ enum class Token_kind : uint8_t
     Symbol_rbrace,
     Symbol_lbracket,
     Symbol_rbracket,
+    Symbol_less,
+    Symbol_greater,
 
     // Identifiers and literals
     Identifier,
@@ -0,0 +1,99 @@
+#ifndef PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_TRIVIA_POLICY_HPP
+#define PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_TRIVIA_POLICY_HPP
+
+#include <cstdint>
+#include <initializer_list>
+
+#include "tokens.hpp"
+
+namespace parser::idl
+{
+/**
+ * @brief Set of token kinds stored as a bitmask, usable in constant expressions.
+ */
+class Token_set
+{
+public:
+    static_assert(static_cast<unsigned>(Token_kind::Multi_line_comment) < 64, "Token_kind no longer fits a mask");
+
+    constexpr Token_set() noexcept = default;
+
+    constexpr Token_set(const std::initializer_list<Token_kind> kinds) noexcept
+    {
+        for (const auto kind : kinds)
+        {
+            bits_ |= bit(kind);
+        }
+    }
+
+    [[nodiscard]] constexpr bool contains(const Token_kind kind) const noexcept
+    {
+        return (bits_ & bit(kind)) != 0;
+    }
+
+    [[nodiscard]] constexpr Token_set operator|(const Token_set other) const noexcept
+    {
+        Token_set set;
+
+        set.bits_ = bits_ | other.bits_;
+
+        return set;
+    }
+
+    [[nodiscard]] constexpr bool operator==(const Token_set&) const noexcept = default;
+
+private:
+    [[nodiscard]] static constexpr uint64_t bit(const Token_kind kind) noexcept
+    {
+        return uint64_t{1} << static_cast<unsigned>(kind);
+    }
+
+    uint64_t bits_{0};
+};
+
+/**
+ * @brief Whitespace and line breaks.
+ */
+inline constexpr Token_set layout_trivia{Token_kind::Whitespace, Token_kind::Newline};
+
+/**
+ * @brief Single- and multi-line comments.
+ */
+inline constexpr Token_set comment_trivia{Token_kind::Single_line_comment, Token_kind::Multi_line_comment};
+
+/**
+ * @brief Which tokens a `Token_reader` filters out, and whether filtered comments are kept aside.
+ */
+struct Trivia_policy
+{
+    /**
+     * @brief Kinds dropped before they reach the lookahead or a tape.
+     */
+    Token_set skip{layout_trivia};
+
+    /**
+     * @brief Record skipped comments in the reader's `Comment_table`.
+     */
+    bool record_comments{false};
+
+    [[nodiscard]] constexpr bool operator==(const Trivia_policy&) const noexcept = default;
+};
+
+/**
+ * @brief The default: comments are returned like any other token.
+ */
+inline constexpr Trivia_policy keep_comments{.skip = layout_trivia, .record_comments = false};
+
+/**
+ * @brief Comments are dropped along with layout, so parsers never see them.
+ */
+inline constexpr Trivia_policy skip_comments{.skip = layout_trivia | comment_trivia, .record_comments = false};
+
+/**
+ * @brief Comments are dropped from the token stream but recorded in the side table, e.g. for documentation.
+ */
+inline constexpr Trivia_policy collect_comments{.skip = layout_trivia | comment_trivia, .record_comments = true};
+
+} // namespace parser::idl
+
+#endif // PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_TRIVIA_POLICY_HPP
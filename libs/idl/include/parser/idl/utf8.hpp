@@ -0,0 +1,75 @@
+#ifndef PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_UTF8_HPP
+#define PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_UTF8_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "isa.hpp"
+
+namespace parser::idl
+{
+/**
+ * @brief Unit in which columns are counted.
+ */
+enum class Column_unit : uint8_t
+{
+    /**
+     * Bytes of UTF-8, matching byte offsets.
+     */
+    Bytes,
+
+    /**
+     * Unicode code points, as editors usually display them.
+     */
+    Code_points,
+
+    /**
+     * UTF-16 code units, as the Language Server Protocol counts them by default.
+     */
+    Utf16,
+};
+
+/**
+ * @brief Vectorized measurement of UTF-8 text.
+ *
+ * Lengths are derived from byte classes alone: every byte that is not a continuation byte (`10xxxxxx`) starts a
+ * code point, and every byte starting a 4-byte sequence (`11110xxx`) adds a second UTF-16 unit. Whole blocks are
+ * classified with one compare and a population count, so non-ASCII text is measured as fast as ASCII. Invalid
+ * sequences are not diagnosed; they are counted by the same rules. The instruction set is selected at runtime
+ * like for `Newline_normalizer`.
+ */
+class Utf8
+{
+public:
+    /**
+     * @brief Returns true if `text` holds only ASCII bytes.
+     */
+    [[nodiscard]] static bool ascii(std::string_view text, Isa isa = detected_isa()) noexcept;
+
+    /**
+     * @brief Number of code points in `text`.
+     */
+    [[nodiscard]] static std::size_t code_points(std::string_view text, Isa isa = detected_isa()) noexcept;
+
+    /**
+     * @brief Number of UTF-16 code units encoding the code points of `text`.
+     */
+    [[nodiscard]] static std::size_t utf16_units(std::string_view text, Isa isa = detected_isa()) noexcept;
+
+    /**
+     * @brief Length of `text` in `unit`.
+     */
+    [[nodiscard]] static std::size_t length(
+            std::string_view text, Column_unit unit, Isa isa = detected_isa()) noexcept;
+
+private:
+    /**
+     * @brief Number of bytes of `text` greater than `threshold` as signed values.
+     */
+    static std::size_t count_above(std::string_view text, signed char threshold, Isa isa) noexcept;
+};
+
+} // namespace parser::idl
+
+#endif // PARSER_LIBS_IDL_INCLUDE_PARSER_IDL_UTF8_HPP
@@ -0,0 +1,64 @@
+#include "parser/idl/arena.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace parser::idl
+{
+Arena::Arena(const std::size_t block_size) noexcept : block_size_{std::max<std::size_t>(block_size, 1)}
+{}
+
+void* Arena::allocate(const std::size_t size, const std::size_t alignment)
+{
+    const auto address{reinterpret_cast<std::uintptr_t>(cursor_)};
+
+    const auto padding{(alignment - address % alignment) % alignment};
+
+    if (!cursor_ || padding + size > static_cast<std::size_t>(end_ - cursor_))
+    {
+        // Requests larger than a block get a block of their own, sized with room for alignment.
+        const auto block_size{std::max(block_size_, size + alignment)};
+
+        blocks_.push_back({std::make_unique_for_overwrite<std::byte[]>(block_size), block_size});
+
+        cursor_ = blocks_.back().data.get();
+
+        end_ = cursor_ + block_size;
+
+        return allocate(size, alignment);
+    }
+
+    auto* const result{cursor_ + padding};
+
+    cursor_ = result + size;
+
+    bytes_ += padding + size;
+
+    return result;
+}
+
+void Arena::reset() noexcept
+{
+    if (!blocks_.empty())
+    {
+        blocks_.erase(blocks_.begin() + 1, blocks_.end());
+
+        cursor_ = blocks_.front().data.get();
+
+        end_ = cursor_ + blocks_.front().size;
+    }
+
+    bytes_ = 0;
+}
+
+std::size_t Arena::blocks() const noexcept
+{
+    return blocks_.size();
+}
+
+std::size_t Arena::bytes() const noexcept
+{
+    return bytes_;
+}
+
+} // namespace parser::idl
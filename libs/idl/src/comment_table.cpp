@@ -0,0 +1,58 @@
+#include "parser/idl/comment_table.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace parser::idl
+{
+std::size_t Comment_table::size() const noexcept
+{
+    return entries_.size();
+}
+
+bool Comment_table::empty() const noexcept
+{
+    return entries_.empty();
+}
+
+std::span<const Comment_table::Entry> Comment_table::entries() const noexcept
+{
+    return entries_;
+}
+
+std::span<const Comment_table::Entry> Comment_table::before(const std::size_t token) const noexcept
+{
+    const auto [first, last]{std::ranges::equal_range(entries_, token, {}, &Entry::token)};
+
+    return {first, last};
+}
+
+std::string_view Comment_table::text(const Entry& entry) const noexcept
+{
+    return std::string_view{text_}.substr(entry.offset, entry.length);
+}
+
+void Comment_table::add(const std::size_t token, const std::string_view text)
+{
+    constexpr std::size_t limit{std::numeric_limits<uint32_t>::max()};
+
+    if (token > limit || text_.size() + text.size() > limit)
+    {
+        throw std::length_error("Comment_table: too many comments");
+    }
+
+    entries_.push_back(
+            {static_cast<uint32_t>(token), static_cast<uint32_t>(text_.size()), static_cast<uint32_t>(text.size())});
+
+    text_.append(text);
+}
+
+void Comment_table::clear() noexcept
+{
+    entries_.clear();
+
+    text_.clear();
+}
+
+} // namespace parser::idl
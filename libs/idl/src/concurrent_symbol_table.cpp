@@ -0,0 +1,123 @@
+#include "parser/idl/concurrent_symbol_table.hpp"
+
+#include <bit>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+
+namespace parser::idl
+{
+Concurrent_symbol_table::Concurrent_symbol_table(const std::span<const std::string_view> seeds)
+{
+    for (const auto name : well_known_symbols)
+    {
+        intern(name);
+    }
+
+    for (const auto name : seeds)
+    {
+        intern(name);
+    }
+}
+
+Symbol_id Concurrent_symbol_table::intern(const std::string_view name)
+{
+    auto& shard{shards_[this->shard(std::hash<std::string_view>{}(name))]};
+
+    {
+        const std::shared_lock lock{shard.mutex};
+
+        if (const auto found{shard.symbols.find(name)}; found != shard.symbols.end())
+        {
+            return found->second;
+        }
+    }
+
+    const std::unique_lock lock{shard.mutex};
+
+    // Another thread may have interned the name between releasing the shared lock and taking this one.
+    if (const auto found{shard.symbols.find(name)}; found != shard.symbols.end())
+    {
+        return found->second;
+    }
+
+    auto symbol{next_.load(std::memory_order_relaxed)};
+
+    do
+    {
+        if (symbol == no_symbol)
+        {
+            throw std::length_error("Concurrent_symbol_table: too many symbols");
+        }
+    } while (!next_.compare_exchange_weak(symbol, symbol + 1, std::memory_order_relaxed));
+
+    const auto stored{shard.arena.copy(std::span<const char>{name})};
+
+    const std::string_view spelling{stored.data(), stored.size()};
+
+    publish(symbol, spelling);
+
+    shard.symbols.emplace(spelling, symbol);
+
+    return symbol;
+}
+
+std::optional<Symbol_id> Concurrent_symbol_table::find(const std::string_view name) const
+{
+    const auto& shard{shards_[this->shard(std::hash<std::string_view>{}(name))]};
+
+    const std::shared_lock lock{shard.mutex};
+
+    const auto found{shard.symbols.find(name)};
+
+    return found == shard.symbols.end() ? std::nullopt : std::optional{found->second};
+}
+
+std::string_view Concurrent_symbol_table::spelling(const Symbol_id symbol) const noexcept
+{
+    const auto [chunk, entry]{locate(symbol)};
+
+    return chunks_[chunk].load(std::memory_order_acquire)[entry];
+}
+
+std::size_t Concurrent_symbol_table::size() const noexcept
+{
+    return next_.load(std::memory_order_relaxed);
+}
+
+void Concurrent_symbol_table::publish(const Symbol_id symbol, const std::string_view name)
+{
+    const auto [chunk, entry]{locate(symbol)};
+
+    auto* entries{chunks_[chunk].load(std::memory_order_acquire)};
+
+    if (!entries)
+    {
+        // Threads interning into different shards may race to allocate the same chunk; the loser discards its copy.
+        auto allocated{std::make_unique<std::string_view[]>(first_chunk << chunk)};
+
+        if (chunks_[chunk].compare_exchange_strong(entries, allocated.get(), std::memory_order_acq_rel))
+        {
+            entries = allocated.get();
+
+            owned_[chunk] = std::move(allocated);
+        }
+    }
+
+    entries[entry] = name;
+}
+
+std::pair<std::size_t, std::size_t> Concurrent_symbol_table::locate(const Symbol_id symbol) noexcept
+{
+    // Chunk k starts at first_chunk * (2^k - 1).
+    const auto chunk{static_cast<std::size_t>(std::bit_width(symbol / first_chunk + 1)) - 1};
+
+    return {chunk, symbol - first_chunk * ((std::size_t{1} << chunk) - 1)};
+}
+
+std::size_t Concurrent_symbol_table::shard(const std::size_t hash) noexcept
+{
+    return hash % shard_count;
+}
+
+} // namespace parser::idl
@@ -0,0 +1,145 @@
+#include "parser/idl/file_prefetcher.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <exception>
+#include <system_error>
+#include <utility>
+
+#include "parser/idl/mapped_file.hpp"
+#include "parser/idl/newline_normalizer.hpp"
+
+namespace parser::idl
+{
+File_prefetcher::File_prefetcher(std::vector<std::filesystem::path> files, const std::size_t depth)
+    : File_prefetcher{std::move(files), &File_prefetcher::load, depth}
+{}
+
+File_prefetcher::File_prefetcher(std::vector<std::filesystem::path> files, Source_t source, const std::size_t depth)
+    : files_{std::move(files)}, source_{std::move(source)}, depth_{std::max<std::size_t>(depth, 1)}
+{
+    thread_ = std::jthread{[this] { work(); }};
+}
+
+File_prefetcher::~File_prefetcher()
+{
+    {
+        const std::lock_guard lock{mutex_};
+
+        stop_ = true;
+    }
+
+    room_.notify_one();
+}
+
+std::optional<File_prefetcher::Result_t> File_prefetcher::next()
+{
+    std::unique_lock lock{mutex_};
+
+    if (taken_ == files_.size())
+    {
+        return std::nullopt;
+    }
+
+    ready_.wait(lock, [this] { return !queue_.empty(); });
+
+    auto result{std::move(queue_.front())};
+
+    queue_.pop_front();
+
+    ++taken_;
+
+    lock.unlock();
+
+    room_.notify_one();
+
+    return result;
+}
+
+const std::vector<std::filesystem::path>& File_prefetcher::files() const noexcept
+{
+    return files_;
+}
+
+std::size_t File_prefetcher::depth() const noexcept
+{
+    return depth_;
+}
+
+File_prefetcher::Result_t File_prefetcher::load(const std::filesystem::path& file)
+{
+    try
+    {
+        if (std::error_code error; std::filesystem::is_regular_file(file, error))
+        {
+            const Mapped_file mapped{file};
+
+            return Newline_normalizer::normalize(mapped.view());
+        }
+
+        std::ifstream stream{file, std::ios::binary};
+
+        if (!stream.is_open())
+        {
+            return std::unexpected(Diagnostic{.file = file, .message = "cannot open file: " + file.string()});
+        }
+
+        std::string text{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+
+        Newline_normalizer::normalize(text);
+
+        return text;
+    }
+    catch (const std::exception& error)
+    {
+        return std::unexpected(Diagnostic{.file = file, .message = error.what()});
+    }
+}
+
+File_prefetcher::Result_t File_prefetcher::read(const std::filesystem::path& file) const
+{
+    // An exception escaping the I/O thread would terminate, and a file never queued would block `next()` forever.
+    try
+    {
+        return source_(file);
+    }
+    catch (const std::exception& error)
+    {
+        return std::unexpected(Diagnostic{.file = file, .message = error.what()});
+    }
+    catch (...)
+    {
+        return std::unexpected(Diagnostic{.file = file, .message = "cannot read file: " + file.string()});
+    }
+}
+
+void File_prefetcher::work()
+{
+    for (const auto& file : files_)
+    {
+        {
+            std::unique_lock lock{mutex_};
+
+            room_.wait(lock, [this] { return stop_ || queue_.size() < depth_; });
+
+            if (stop_)
+            {
+                return;
+            }
+        }
+
+        // Read outside the lock so the caller can take earlier files meanwhile.
+        auto result{read(file)};
+
+        {
+            const std::lock_guard lock{mutex_};
+
+            queue_.push_back(std::move(result));
+        }
+
+        ready_.notify_one();
+    }
+}
+
+} // namespace parser::idl
@@ -0,0 +1,29 @@
+#include "parser/idl/isa.hpp"
+
+namespace parser::idl
+{
+Isa detected_isa() noexcept
+{
+    static const Isa isa{isa_supported(Isa::Avx2) ? Isa::Avx2 : isa_supported(Isa::Sse2) ? Isa::Sse2 : Isa::Scalar};
+
+    return isa;
+}
+
+bool isa_supported(const Isa isa) noexcept
+{
+    switch (isa)
+    {
+#if defined(__x86_64__) || defined(__i386__)
+    case Isa::Avx2:
+        return __builtin_cpu_supports("avx2");
+    case Isa::Sse2:
+        return __builtin_cpu_supports("sse2");
+#endif
+    case Isa::Scalar:
+        return true;
+    default:
+        return false;
+    }
+}
+
+} // namespace parser::idl
@@ -0,0 +1,75 @@
+#include "parser/idl/lexer_factory.hpp"
+
+#include <lexer/regex/any_of.hpp>
+#include <lexer/regex/choice.hpp>
+#include <lexer/regex/concat.hpp>
+#include <lexer/regex/repeat.hpp>
+#include <lexer/regex/text.hpp>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "parser/idl/keywords.hpp"
+#include "parser/idl/tokens.hpp"
+
+namespace parser::idl
+{
+lexer::core::Lexer Lexer_factory::build(const Keyword_mode mode)
+{
+    using namespace lexer::core;
+    using namespace lexer::regex;
+
+    Builder builder;
+
+    if (mode == Keyword_mode::Rules)
+    {
+        for (const auto& [spelling, kind] : Keywords::table)
+        {
+            builder.add_token(text(std::string{spelling}), kind, 1);
+        }
+    }
+
+    constexpr std::pair<std::string_view, Token_kind> symbols[]{
+            {";", Token_kind::Symbol_semicolon},  {":", Token_kind::Symbol_colon},    {",", Token_kind::Symbol_comma},
+            {"=", Token_kind::Symbol_equals},     {"(", Token_kind::Symbol_lparen},   {")", Token_kind::Symbol_rparen},
+            {"{", Token_kind::Symbol_lbrace},     {"}", Token_kind::Symbol_rbrace},   {"[", Token_kind::Symbol_lbracket},
+            {"]", Token_kind::Symbol_rbracket},   {"<", Token_kind::Symbol_less},     {">", Token_kind::Symbol_greater},
+            {"+", Token_kind::Operator_plus},     {"-", Token_kind::Operator_minus},  {"*", Token_kind::Operator_asterisk},
+            {"/", Token_kind::Operator_slash},
+    };
+
+    for (const auto& [symbol, kind] : symbols)
+    {
+        builder.add_token(text(std::string{symbol}), kind, 1);
+    }
+
+    const auto digit{any_of(Set::digits())};
+
+    const auto sign{choice(text("+"), text("-"))};
+
+    const auto exponent{concat(choice(text("e"), text("E")), optional(sign), plus(digit))};
+
+    const auto fraction{choice(
+            concat(plus(digit), text("."), kleene(digit), optional(exponent)),
+            concat(text("."), plus(digit), optional(exponent)), concat(plus(digit), exponent))};
+
+    builder.add_token(
+            concat(any_of(Set::alpha() + '_'), kleene(any_of(Set::alphanum() + '_'))), Token_kind::Identifier, 4);
+    builder.add_token(plus(digit), Token_kind::Integer_literal, 2);
+    builder.add_token(concat(plus(digit), text("."), plus(digit)), Token_kind::Fixed_point_literal, 2);
+    builder.add_token(concat(optional(sign), fraction), Token_kind::Floating_point_literal, 3);
+    builder.add_token(
+            concat(text("\""), kleene(any_of(Set::printable())), text("\"")), Token_kind::String_literal, 2);
+    builder.add_token(
+            concat(text("//"), kleene(any_of(Set::printable() + Set::escape() - Set::newline()))),
+            Token_kind::Single_line_comment, 0);
+    builder.add_token(
+            concat(text("/*"), kleene(any_of(Set::printable() + Set::escape())), text("*/")),
+            Token_kind::Multi_line_comment, 0);
+    builder.add_token(plus(any_of(Set::whitespace())), Token_kind::Whitespace, 0);
+    builder.add_token(plus(any_of(Set::newline())), Token_kind::Newline, 0);
+
+    return builder.build();
+}
+
+} // namespace parser::idl
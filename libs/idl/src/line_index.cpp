@@ -0,0 +1,144 @@
+#include "parser/idl/line_index.hpp"
+
+#include <bit>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define PARSER_IDL_LINE_INDEX_X86 1
+#endif
+
+namespace parser::idl
+{
+namespace
+{
+void scan_scalar(const char* data, const std::size_t base, const std::size_t size, std::vector<std::size_t>& starts)
+{
+    for (std::size_t index = 0; index < size; ++index)
+    {
+        if (data[index] == '\n')
+        {
+            starts.push_back(base + index + 1);
+        }
+    }
+}
+
+/**
+ * Append the start of the line following every newline flagged in `mask`.
+ */
+inline void push_starts(unsigned mask, const std::size_t base, std::vector<std::size_t>& starts)
+{
+    for (; mask != 0; mask &= mask - 1)
+    {
+        starts.push_back(base + static_cast<std::size_t>(std::countr_zero(mask)) + 1);
+    }
+}
+
+#ifdef PARSER_IDL_LINE_INDEX_X86
+
+__attribute__((target("sse2"))) void scan_sse2(const char* data, const std::size_t size, std::vector<std::size_t>& starts)
+{
+    const auto newline{_mm_set1_epi8('\n')};
+
+    std::size_t index{0};
+
+    for (; index + 16 <= size; index += 16)
+    {
+        const auto block{_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + index))};
+
+        push_starts(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, newline))), index, starts);
+    }
+
+    scan_scalar(data + index, index, size - index, starts);
+}
+
+__attribute__((target("avx2"))) void scan_avx2(const char* data, const std::size_t size, std::vector<std::size_t>& starts)
+{
+    const auto newline{_mm256_set1_epi8('\n')};
+
+    std::size_t index{0};
+
+    for (; index + 32 <= size; index += 32)
+    {
+        const auto block{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index))};
+
+        push_starts(static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, newline))), index, starts);
+    }
+
+    scan_scalar(data + index, index, size - index, starts);
+}
+
+#endif
+
+} // namespace
+
+Line_index::Line_index()
+{
+    starts_.values().push_back(0);
+}
+
+Line_index::Line_index(const std::string_view input, const Isa isa)
+{
+    build(input, isa);
+}
+
+void Line_index::build(const std::string_view input, const Isa isa)
+{
+    auto& starts{starts_.values()};
+
+    starts.clear();
+
+    starts.push_back(0);
+
+    switch (isa)
+    {
+#ifdef PARSER_IDL_LINE_INDEX_X86
+    case Isa::Avx2:
+        scan_avx2(input.data(), input.size(), starts);
+        break;
+    case Isa::Sse2:
+        scan_sse2(input.data(), input.size(), starts);
+        break;
+#endif
+    default:
+        scan_scalar(input.data(), 0, input.size(), starts);
+        break;
+    }
+}
+
+void Line_index::replace(const std::size_t offset, const std::size_t length, const std::string_view text)
+{
+    const auto first{starts_.upper_bound(offset)};
+
+    const auto last{starts_.upper_bound(offset + length)};
+
+    std::vector<std::size_t> inserted;
+
+    scan_scalar(text.data(), offset, text.size(), inserted);
+
+    starts_.splice(first, last, inserted, text.size() - length);
+}
+
+std::size_t Line_index::line(const std::size_t offset) const noexcept
+{
+    return starts_.upper_bound(offset);
+}
+
+std::size_t Line_index::column(const std::size_t offset) const noexcept
+{
+    return offset - starts_[line(offset) - 1] + 1;
+}
+
+std::size_t Line_index::column(
+        const std::size_t offset, const std::string_view input, const Column_unit unit) const noexcept
+{
+    const auto start{starts_[line(offset) - 1]};
+
+    return Utf8::length(input.substr(start, offset - start), unit) + 1;
+}
+
+std::size_t Line_index::lines() const noexcept
+{
+    return starts_.size();
+}
+
+} // namespace parser::idl
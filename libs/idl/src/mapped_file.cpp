@@ -0,0 +1,98 @@
+#include "parser/idl/mapped_file.hpp"
+
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace parser::idl
+{
+Mapped_file::Mapped_file(const std::filesystem::path& file) : data_{nullptr}, size_{0}
+{
+    const int descriptor{::open(file.c_str(), O_RDONLY | O_CLOEXEC)};
+
+    if (descriptor < 0)
+    {
+        throw std::runtime_error("Mapped_file: cannot open file: " + file.string());
+    }
+
+    struct stat status{};
+
+    if (::fstat(descriptor, &status) != 0 || !S_ISREG(status.st_mode))
+    {
+        ::close(descriptor);
+
+        throw std::runtime_error("Mapped_file: not a regular file: " + file.string());
+    }
+
+    if (status.st_size > 0)
+    {
+        const auto size{static_cast<std::size_t>(status.st_size)};
+
+        void* address{::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0)};
+
+        if (address == MAP_FAILED)
+        {
+            ::close(descriptor);
+
+            throw std::runtime_error("Mapped_file: cannot map file: " + file.string());
+        }
+
+        ::madvise(address, size, MADV_SEQUENTIAL);
+
+        data_ = static_cast<const char*>(address);
+
+        size_ = size;
+    }
+
+    ::close(descriptor);
+}
+
+Mapped_file::Mapped_file(Mapped_file&& other) noexcept
+    : data_{std::exchange(other.data_, nullptr)}, size_{std::exchange(other.size_, 0)}
+{}
+
+Mapped_file& Mapped_file::operator=(Mapped_file&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+
+        data_ = std::exchange(other.data_, nullptr);
+
+        size_ = std::exchange(other.size_, 0);
+    }
+
+    return *this;
+}
+
+Mapped_file::~Mapped_file()
+{
+    release();
+}
+
+std::string_view Mapped_file::view() const noexcept
+{
+    return {data_, size_};
+}
+
+std::size_t Mapped_file::size() const noexcept
+{
+    return size_;
+}
+
+void Mapped_file::release() noexcept
+{
+    if (data_ != nullptr)
+    {
+        ::munmap(const_cast<char*>(data_), size_);
+
+        data_ = nullptr;
+
+        size_ = 0;
+    }
+}
+
+} // namespace parser::idl
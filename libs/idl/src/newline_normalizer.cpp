@@ -0,0 +1,281 @@
+#include "parser/idl/newline_normalizer.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define PARSER_IDL_NEWLINE_NORMALIZER_X86 1
+#endif
+
+namespace parser::idl
+{
+namespace
+{
+/**
+ * Write the '\n' replacing the '\r' at `read` and step past it, swallowing a directly following '\n'.
+ */
+inline void replace_carriage_return(
+        const char* source, const std::size_t size, char* target, std::size_t& read, std::size_t& written) noexcept
+{
+    target[written++] = '\n';
+
+    read += read + 1 < size && source[read + 1] == '\n' ? 2 : 1;
+}
+
+std::size_t find_scalar(const char* data, const std::size_t size) noexcept
+{
+    const auto* found{std::find(data, data + size, '\r')};
+
+    return found == data + size ? std::string_view::npos : static_cast<std::size_t>(found - data);
+}
+
+std::size_t compact_scalar(const char* source, const std::size_t size, char* target) noexcept
+{
+    std::size_t read{0};
+
+    std::size_t written{0};
+
+    while (read < size)
+    {
+        if (source[read] == '\r')
+        {
+            replace_carriage_return(source, size, target, read, written);
+        }
+        else
+        {
+            target[written++] = source[read++];
+        }
+    }
+
+    return written;
+}
+
+#ifdef PARSER_IDL_NEWLINE_NORMALIZER_X86
+
+__attribute__((target("sse2"))) std::size_t find_sse2(const char* data, const std::size_t size) noexcept
+{
+    const auto carriage_return{_mm_set1_epi8('\r')};
+
+    std::size_t index{0};
+
+    for (; index + 16 <= size; index += 16)
+    {
+        const auto block{_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + index))};
+
+        if (const auto mask{static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, carriage_return)))}; mask)
+        {
+            return index + static_cast<std::size_t>(std::countr_zero(mask));
+        }
+    }
+
+    const auto tail{find_scalar(data + index, size - index)};
+
+    return tail == std::string_view::npos ? tail : index + tail;
+}
+
+__attribute__((target("sse2"))) std::size_t compact_sse2(
+        const char* source, const std::size_t size, char* target) noexcept
+{
+    const auto carriage_return{_mm_set1_epi8('\r')};
+
+    std::size_t read{0};
+
+    std::size_t written{0};
+
+    while (read < size)
+    {
+        if (size - read >= 16)
+        {
+            const auto block{_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + read))};
+
+            const auto mask{static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, carriage_return)))};
+
+            if (mask == 0)
+            {
+                // The block is already in a register, so storing it is safe even when compacting in place.
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(target + written), block);
+
+                read += 16;
+
+                written += 16;
+
+                continue;
+            }
+
+            const auto prefix{static_cast<std::size_t>(std::countr_zero(mask))};
+
+            std::memmove(target + written, source + read, prefix);
+
+            read += prefix;
+
+            written += prefix;
+        }
+        else if (source[read] != '\r')
+        {
+            target[written++] = source[read++];
+
+            continue;
+        }
+
+        replace_carriage_return(source, size, target, read, written);
+    }
+
+    return written;
+}
+
+__attribute__((target("avx2"))) std::size_t find_avx2(const char* data, const std::size_t size) noexcept
+{
+    const auto carriage_return{_mm256_set1_epi8('\r')};
+
+    std::size_t index{0};
+
+    for (; index + 64 <= size; index += 64)
+    {
+        const auto low{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index))};
+
+        const auto high{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index + 32))};
+
+        const auto matches{
+                _mm256_or_si256(_mm256_cmpeq_epi8(low, carriage_return), _mm256_cmpeq_epi8(high, carriage_return))};
+
+        if (_mm256_testz_si256(matches, matches) == 0)
+        {
+            break;
+        }
+    }
+
+    for (; index + 32 <= size; index += 32)
+    {
+        const auto block{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index))};
+
+        if (const auto mask{static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, carriage_return)))};
+            mask)
+        {
+            return index + static_cast<std::size_t>(std::countr_zero(mask));
+        }
+    }
+
+    const auto tail{find_scalar(data + index, size - index)};
+
+    return tail == std::string_view::npos ? tail : index + tail;
+}
+
+__attribute__((target("avx2"))) std::size_t compact_avx2(
+        const char* source, const std::size_t size, char* target) noexcept
+{
+    const auto carriage_return{_mm256_set1_epi8('\r')};
+
+    std::size_t read{0};
+
+    std::size_t written{0};
+
+    while (read < size)
+    {
+        if (size - read >= 32)
+        {
+            const auto block{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + read))};
+
+            const auto mask{static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, carriage_return)))};
+
+            if (mask == 0)
+            {
+                // The block is already in a register, so storing it is safe even when compacting in place.
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(target + written), block);
+
+                read += 32;
+
+                written += 32;
+
+                continue;
+            }
+
+            const auto prefix{static_cast<std::size_t>(std::countr_zero(mask))};
+
+            std::memmove(target + written, source + read, prefix);
+
+            read += prefix;
+
+            written += prefix;
+        }
+        else if (source[read] != '\r')
+        {
+            target[written++] = source[read++];
+
+            continue;
+        }
+
+        replace_carriage_return(source, size, target, read, written);
+    }
+
+    return written;
+}
+
+#endif
+
+} // namespace
+
+std::size_t Newline_normalizer::find_carriage_return(const std::string_view input, const Isa isa) noexcept
+{
+    switch (isa)
+    {
+#ifdef PARSER_IDL_NEWLINE_NORMALIZER_X86
+    case Isa::Avx2:
+        return find_avx2(input.data(), input.size());
+    case Isa::Sse2:
+        return find_sse2(input.data(), input.size());
+#endif
+    default:
+        return find_scalar(input.data(), input.size());
+    }
+}
+
+std::string Newline_normalizer::normalize(const std::string_view input, const Isa isa)
+{
+    const auto first{find_carriage_return(input, isa)};
+
+    if (first == std::string_view::npos)
+    {
+        return std::string{input};
+    }
+
+    std::string output;
+
+    output.resize_and_overwrite(input.size(), [&input, first, isa](char* data, const std::size_t) noexcept {
+        std::memcpy(data, input.data(), first);
+
+        return first + compact(input.data() + first, input.size() - first, data + first, isa);
+    });
+
+    return output;
+}
+
+void Newline_normalizer::normalize(std::string& buffer, const Isa isa) noexcept
+{
+    const auto first{find_carriage_return(buffer, isa)};
+
+    if (first == std::string_view::npos)
+    {
+        return;
+    }
+
+    buffer.resize(first + compact(buffer.data() + first, buffer.size() - first, buffer.data() + first, isa));
+}
+
+std::size_t Newline_normalizer::compact(const char* source, const std::size_t size, char* target, const Isa isa) noexcept
+{
+    switch (isa)
+    {
+#ifdef PARSER_IDL_NEWLINE_NORMALIZER_X86
+    case Isa::Avx2:
+        return compact_avx2(source, size, target);
+    case Isa::Sse2:
+        return compact_sse2(source, size, target);
+#endif
+    default:
+        return compact_scalar(source, size, target);
+    }
+}
+
+} // namespace parser::idl
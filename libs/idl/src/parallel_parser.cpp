@@ -0,0 +1,296 @@
+#include "parser/idl/parallel_parser.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <utility>
+
+#include "parser/idl/newline_normalizer.hpp"
+#include "parser/idl/source_scanner.hpp"
+
+namespace parser::idl
+{
+namespace
+{
+/**
+ * Start of the reader's input buffer. The reader does not expose it, so it is recovered from the first token and
+ * the offset right after it.
+ */
+const char* buffer_start(Token_reader& reader)
+{
+    const auto first{reader.peek()};
+
+    if (!first || !*first)
+    {
+        return nullptr;
+    }
+
+    const auto lexeme{first->value().lexeme()};
+
+    return lexeme.data() + lexeme.size() - reader.location(0).offset();
+}
+
+} // namespace
+
+Parallel_parser::Parallel_parser(
+        std::shared_ptr<const lexer::core::Lexer> lexer, const std::size_t threads, const std::size_t region_bytes)
+    : lexer_{std::move(lexer)}, pool_{threads}, region_bytes_{std::max<std::size_t>(region_bytes, 1)}
+{}
+
+Parallel_parser::Result_t Parallel_parser::parse(std::string text)
+{
+    Newline_normalizer::normalize(text);
+
+    text_ = std::move(text);
+
+    lines_.build(text_);
+
+    root_.reset();
+
+    auto regions{split(text_, pool_.size() * 4, region_bytes_)};
+
+    if (!regions || regions->size() < 2)
+    {
+        return sequential();
+    }
+
+    regions_ = std::move(*regions);
+
+    while (slots_.size() < regions_.size())
+    {
+        slots_.push_back(std::make_unique<Slot>());
+    }
+
+    std::vector<std::size_t> order(regions_.size());
+
+    std::iota(order.begin(), order.end(), 0);
+
+    pool_.run(order, [this](const std::size_t index, const std::size_t) {
+        parse_region(*slots_[index], regions_[index]);
+    });
+
+    std::size_t definitions{0};
+
+    for (std::size_t index{0}; index < regions_.size(); ++index)
+    {
+        const auto& result{slots_[index]->result};
+
+        // A region may fail where the whole text would report a different error (e.g. end of input instead of the
+        // next region's first token), so errors always come from a sequential parse.
+        if (!result)
+        {
+            return sequential();
+        }
+
+        definitions += (*result)->definitions.size();
+    }
+
+    std::vector<const ast::Definition*> stitched;
+
+    stitched.reserve(definitions);
+
+    for (std::size_t index{0}; index < regions_.size(); ++index)
+    {
+        std::ranges::copy((*slots_[index]->result)->definitions, std::back_inserter(stitched));
+    }
+
+    return root_.create<ast::Specification>(root_.copy(std::span<const ast::Definition* const>{stitched}));
+}
+
+std::span<const Parallel_parser::Region> Parallel_parser::regions() const noexcept
+{
+    return regions_;
+}
+
+std::string_view Parallel_parser::text() const noexcept
+{
+    return text_;
+}
+
+std::size_t Parallel_parser::offset(const std::string_view name) const noexcept
+{
+    const std::less<const char*> before;
+
+    for (std::size_t index{0}; index < regions_.size(); ++index)
+    {
+        const auto* const buffer{slots_[index]->buffer};
+
+        if (buffer && !before(name.data(), buffer) && before(name.data(), buffer + regions_[index].length))
+        {
+            return regions_[index].offset + static_cast<std::size_t>(name.data() - buffer);
+        }
+    }
+
+    return text_.size();
+}
+
+std::size_t Parallel_parser::line(const std::size_t offset) const noexcept
+{
+    return lines_.line(offset);
+}
+
+std::size_t Parallel_parser::column(const std::size_t offset) const noexcept
+{
+    return lines_.column(offset);
+}
+
+std::size_t Parallel_parser::threads() const noexcept
+{
+    return pool_.size();
+}
+
+std::optional<std::vector<Parallel_parser::Region>> Parallel_parser::split(
+        const std::string_view text, const std::size_t regions, const std::size_t region_bytes)
+{
+    // Offsets of the lines following a top-level ';' (blank lines in between are fine), where a region may start.
+    std::vector<std::size_t> candidates;
+
+    std::size_t depth{0};
+
+    bool closed{false};
+
+    for (std::size_t position{0}; position < text.size();)
+    {
+        const auto character{text[position]};
+
+        if (character == '"')
+        {
+            position = Source_scanner::string_end(text, position);
+
+            if (position == std::string_view::npos)
+            {
+                return std::nullopt;
+            }
+
+            closed = false;
+
+            continue;
+        }
+
+        if (character == '/' && text.substr(position, 2) == "//")
+        {
+            position = Source_scanner::line_comment_end(text, position);
+
+            continue;
+        }
+
+        if (character == '/' && text.substr(position, 2) == "/*")
+        {
+            position = Source_scanner::comment_end(text, position);
+
+            if (position == std::string_view::npos)
+            {
+                return std::nullopt;
+            }
+
+            continue;
+        }
+
+        switch (character)
+        {
+        case '\n':
+            if (depth == 0 && closed)
+            {
+                candidates.push_back(position + 1);
+            }
+            break;
+        case ' ':
+        case '\t':
+        case '\r':
+        case '\v':
+        case '\f':
+            break;
+        case '#':
+            return std::nullopt;
+        case '{':
+        case '(':
+        case '[':
+            ++depth;
+
+            closed = false;
+            break;
+        case '}':
+        case ')':
+        case ']':
+            if (depth == 0)
+            {
+                return std::nullopt;
+            }
+
+            --depth;
+
+            closed = false;
+            break;
+        case ';':
+            closed = depth == 0;
+            break;
+        default:
+            closed = false;
+            break;
+        }
+
+        ++position;
+    }
+
+    if (depth != 0)
+    {
+        return std::nullopt;
+    }
+
+    const auto count{std::max<std::size_t>(regions, 1)};
+
+    const auto target{std::max(region_bytes, (text.size() + count - 1) / count)};
+
+    std::vector<Region> result;
+
+    std::size_t start{0};
+
+    for (const auto candidate : candidates)
+    {
+        if (candidate - start >= target && text.size() - candidate >= region_bytes)
+        {
+            result.push_back({start, candidate - start});
+
+            start = candidate;
+        }
+    }
+
+    result.push_back({start, text.size() - start});
+
+    return result;
+}
+
+void Parallel_parser::parse_region(Slot& slot, const Region& region)
+{
+    if (!slot.reader)
+    {
+        slot.reader = std::make_unique<Token_reader>(lexer_, Location_mode::Lazy);
+    }
+
+    slot.reader->load(std::string_view{text_}.substr(region.offset, region.length));
+
+    slot.arena.reset();
+
+    slot.buffer = buffer_start(*slot.reader);
+
+    Parser parser{*slot.reader, slot.arena};
+
+    slot.result = parser.parse();
+}
+
+Parallel_parser::Result_t Parallel_parser::sequential()
+{
+    regions_.assign(1, {0, text_.size()});
+
+    if (slots_.empty())
+    {
+        slots_.push_back(std::make_unique<Slot>());
+    }
+
+    parse_region(*slots_.front(), regions_.front());
+
+    return slots_.front()->result;
+}
+
+} // namespace parser::idl
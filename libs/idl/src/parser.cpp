@@ -0,0 +1,799 @@
+#include "parser/idl/parser.hpp"
+
+#include <array>
+#include <utility>
+
+#include "parser/idl/trivia_policy.hpp"
+#include "parser/idl/utf8.hpp"
+
+namespace parser::idl
+{
+namespace
+{
+bool is_literal(const Token_kind kind) noexcept
+{
+    return kind == Token_kind::Integer_literal || kind == Token_kind::Floating_point_literal ||
+           kind == Token_kind::Fixed_point_literal || kind == Token_kind::String_literal ||
+           kind == Token_kind::Character_literal;
+}
+
+/**
+ * Adds comments to the kinds a reader skips for as long as it lives, so the parser never sees them, and restores
+ * the reader's own policy afterwards. Skipped comments are still recorded if the policy records them.
+ */
+class Comment_skipping
+{
+public:
+    explicit Comment_skipping(Token_reader& reader) noexcept : reader_{reader}, policy_{reader.trivia()}
+    {
+        reader_.set_trivia({.skip = policy_.skip | comment_trivia, .record_comments = policy_.record_comments});
+
+        // Comments buffered before the switch were lexed under the old policy.
+        for (const auto* token{reader_.current()}; token && comment_trivia.contains(token->kind());
+             token = reader_.current())
+        {
+            (void) reader_.accept(token->kind());
+        }
+    }
+
+    Comment_skipping(const Comment_skipping&) = delete;
+
+    Comment_skipping& operator=(const Comment_skipping&) = delete;
+
+    ~Comment_skipping()
+    {
+        reader_.set_trivia(policy_);
+    }
+
+private:
+    Token_reader& reader_;
+
+    Trivia_policy policy_;
+};
+
+} // namespace
+
+Parser::Parser(Token_reader& reader, Arena& arena) noexcept : reader_{reader}, arena_{arena}
+{}
+
+Parser::Result_t Parser::parse()
+{
+    std::apply([](auto&... stacks) { (stacks.clear(), ...); }, stacks_);
+
+    const Comment_skipping comments{reader_};
+
+    try
+    {
+        const auto mark{stack<const ast::Definition*>().size()};
+
+        while (current())
+        {
+            stack<const ast::Definition*>().push_back(definition());
+        }
+
+        return arena_.create<ast::Specification>(commit<const ast::Definition*>(mark));
+    }
+    catch (Failure& failure)
+    {
+        return std::unexpected(std::move(failure.diagnostic));
+    }
+}
+
+const ast::Definition* Parser::definition()
+{
+    const ast::Definition* definition{nullptr};
+
+    switch (current() ? current()->kind() : Token_kind::Symbol_semicolon)
+    {
+    case Token_kind::Keyword_module:
+        definition = module_definition();
+        break;
+    case Token_kind::Keyword_interface:
+        definition = interface_definition();
+        break;
+    case Token_kind::Keyword_struct:
+        definition = structure();
+        break;
+    case Token_kind::Keyword_union:
+        definition = union_type();
+        break;
+    case Token_kind::Keyword_enum:
+        definition = enumeration();
+        break;
+    case Token_kind::Keyword_typedef:
+        definition = type_definition();
+        break;
+    case Token_kind::Keyword_const:
+        definition = constant();
+        break;
+    case Token_kind::Keyword_exception:
+        definition = exception();
+        break;
+    default:
+        fail("a definition");
+    }
+
+    expect(Token_kind::Symbol_semicolon, "';'");
+
+    return definition;
+}
+
+const ast::Definition* Parser::export_definition()
+{
+    const ast::Definition* definition{nullptr};
+
+    switch (current() ? current()->kind() : Token_kind::Symbol_semicolon)
+    {
+    case Token_kind::Keyword_attribute:
+        definition = attribute();
+        break;
+    case Token_kind::Keyword_struct:
+        definition = structure();
+        break;
+    case Token_kind::Keyword_union:
+        definition = union_type();
+        break;
+    case Token_kind::Keyword_enum:
+        definition = enumeration();
+        break;
+    case Token_kind::Keyword_typedef:
+        definition = type_definition();
+        break;
+    case Token_kind::Keyword_const:
+        definition = constant();
+        break;
+    case Token_kind::Keyword_exception:
+        definition = exception();
+        break;
+    default:
+        definition = operation();
+        break;
+    }
+
+    expect(Token_kind::Symbol_semicolon, "';'");
+
+    return definition;
+}
+
+const ast::Module* Parser::module_definition()
+{
+    advance();
+
+    const auto name{identifier()};
+
+    expect(Token_kind::Symbol_lbrace, "'{'");
+
+    const auto mark{stack<const ast::Definition*>().size()};
+
+    while (!accept(Token_kind::Symbol_rbrace))
+    {
+        stack<const ast::Definition*>().push_back(definition());
+    }
+
+    return arena_.create<ast::Module>(
+            ast::Definition{ast::Definition_kind::Module, name}, commit<const ast::Definition*>(mark));
+}
+
+const ast::Interface* Parser::interface_definition()
+{
+    advance();
+
+    const auto name{identifier()};
+
+    const auto bases_mark{stack<ast::Scoped_name>().size()};
+
+    if (accept(Token_kind::Symbol_colon))
+    {
+        do
+        {
+            stack<ast::Scoped_name>().push_back(scoped_name());
+        } while (accept(Token_kind::Symbol_comma));
+    }
+
+    const auto bases{commit<ast::Scoped_name>(bases_mark)};
+
+    expect(Token_kind::Symbol_lbrace, "'{'");
+
+    const auto mark{stack<const ast::Definition*>().size()};
+
+    while (!accept(Token_kind::Symbol_rbrace))
+    {
+        stack<const ast::Definition*>().push_back(export_definition());
+    }
+
+    return arena_.create<ast::Interface>(
+            ast::Definition{ast::Definition_kind::Interface, name}, bases, commit<const ast::Definition*>(mark));
+}
+
+const ast::Struct* Parser::structure()
+{
+    advance();
+
+    const auto name{identifier()};
+
+    expect(Token_kind::Symbol_lbrace, "'{'");
+
+    const auto mark{stack<ast::Member>().size()};
+
+    while (!accept(Token_kind::Symbol_rbrace))
+    {
+        stack<ast::Member>().push_back(member());
+    }
+
+    return arena_.create<ast::Struct>(ast::Definition{ast::Definition_kind::Struct, name}, commit<ast::Member>(mark));
+}
+
+const ast::Union* Parser::union_type()
+{
+    advance();
+
+    const auto name{identifier()};
+
+    expect(Token_kind::Keyword_switch, "'switch'");
+
+    expect(Token_kind::Symbol_lparen, "'('");
+
+    const auto* const discriminator{type_spec()};
+
+    expect(Token_kind::Symbol_rparen, "')'");
+
+    expect(Token_kind::Symbol_lbrace, "'{'");
+
+    const auto mark{stack<ast::Case>().size()};
+
+    while (!accept(Token_kind::Symbol_rbrace))
+    {
+        stack<ast::Case>().push_back(union_case());
+    }
+
+    return arena_.create<ast::Union>(
+            ast::Definition{ast::Definition_kind::Union, name}, discriminator, commit<ast::Case>(mark));
+}
+
+ast::Case Parser::union_case()
+{
+    const auto mark{stack<const ast::Expression*>().size()};
+
+    bool is_default{false};
+
+    do
+    {
+        if (accept(Token_kind::Keyword_default))
+        {
+            is_default = true;
+        }
+        else
+        {
+            expect(Token_kind::Keyword_case, "'case' or 'default'");
+
+            stack<const ast::Expression*>().push_back(expression());
+        }
+
+        expect(Token_kind::Symbol_colon, "':'");
+    } while (check(Token_kind::Keyword_case) || check(Token_kind::Keyword_default));
+
+    const auto labels{commit<const ast::Expression*>(mark)};
+
+    const auto* const type{type_spec()};
+
+    const auto element{declarator()};
+
+    expect(Token_kind::Symbol_semicolon, "';'");
+
+    return {labels, is_default, type, element};
+}
+
+const ast::Enum* Parser::enumeration()
+{
+    advance();
+
+    const auto name{identifier()};
+
+    expect(Token_kind::Symbol_lbrace, "'{'");
+
+    const auto mark{stack<std::string_view>().size()};
+
+    do
+    {
+        stack<std::string_view>().push_back(identifier());
+    } while (accept(Token_kind::Symbol_comma));
+
+    expect(Token_kind::Symbol_rbrace, "'}'");
+
+    return arena_.create<ast::Enum>(ast::Definition{ast::Definition_kind::Enum, name}, commit<std::string_view>(mark));
+}
+
+const ast::Typedef* Parser::type_definition()
+{
+    advance();
+
+    const auto* const type{type_spec()};
+
+    const auto mark{stack<ast::Declarator>().size()};
+
+    do
+    {
+        stack<ast::Declarator>().push_back(declarator());
+    } while (accept(Token_kind::Symbol_comma));
+
+    const auto declarators{commit<ast::Declarator>(mark)};
+
+    return arena_.create<ast::Typedef>(
+            ast::Definition{ast::Definition_kind::Typedef, declarators.front().name}, type, declarators);
+}
+
+const ast::Const* Parser::constant()
+{
+    advance();
+
+    const auto* const type{type_spec()};
+
+    const auto name{identifier()};
+
+    expect(Token_kind::Symbol_equals, "'='");
+
+    return arena_.create<ast::Const>(ast::Definition{ast::Definition_kind::Const, name}, type, expression());
+}
+
+const ast::Exception* Parser::exception()
+{
+    advance();
+
+    const auto name{identifier()};
+
+    expect(Token_kind::Symbol_lbrace, "'{'");
+
+    const auto mark{stack<ast::Member>().size()};
+
+    while (!accept(Token_kind::Symbol_rbrace))
+    {
+        stack<ast::Member>().push_back(member());
+    }
+
+    return arena_.create<ast::Exception>(
+            ast::Definition{ast::Definition_kind::Exception, name}, commit<ast::Member>(mark));
+}
+
+const ast::Attribute* Parser::attribute()
+{
+    advance();
+
+    const auto* const type{type_spec()};
+
+    const auto mark{stack<std::string_view>().size()};
+
+    do
+    {
+        stack<std::string_view>().push_back(identifier());
+    } while (accept(Token_kind::Symbol_comma));
+
+    const auto names{commit<std::string_view>(mark)};
+
+    return arena_.create<ast::Attribute>(ast::Definition{ast::Definition_kind::Attribute, names.front()}, type, names);
+}
+
+const ast::Operation* Parser::operation()
+{
+    (void) accept(Token_kind::Keyword_operation);
+
+    const auto* const result{accept(Token_kind::Keyword_void) ? primitive(ast::Primitive::Void) : type_spec()};
+
+    const auto name{identifier()};
+
+    expect(Token_kind::Symbol_lparen, "'('");
+
+    const auto mark{stack<ast::Parameter>().size()};
+
+    if (!check(Token_kind::Symbol_rparen))
+    {
+        do
+        {
+            stack<ast::Parameter>().push_back(parameter());
+        } while (accept(Token_kind::Symbol_comma));
+    }
+
+    expect(Token_kind::Symbol_rparen, "')'");
+
+    const auto parameters{commit<ast::Parameter>(mark)};
+
+    const auto raises_mark{stack<ast::Scoped_name>().size()};
+
+    if (accept(Token_kind::Keyword_raises))
+    {
+        expect(Token_kind::Symbol_lparen, "'('");
+
+        do
+        {
+            stack<ast::Scoped_name>().push_back(scoped_name());
+        } while (accept(Token_kind::Symbol_comma));
+
+        expect(Token_kind::Symbol_rparen, "')'");
+    }
+
+    return arena_.create<ast::Operation>(
+            ast::Definition{ast::Definition_kind::Operation, name}, result, parameters,
+            commit<ast::Scoped_name>(raises_mark));
+}
+
+ast::Parameter Parser::parameter()
+{
+    ast::Direction direction{ast::Direction::In};
+
+    if (accept(Token_kind::Keyword_in))
+    {
+        direction = ast::Direction::In;
+    }
+    else if (accept(Token_kind::Keyword_out))
+    {
+        direction = ast::Direction::Out;
+    }
+    else if (accept(Token_kind::Keyword_inout))
+    {
+        direction = ast::Direction::Inout;
+    }
+    else
+    {
+        fail("'in', 'out' or 'inout'");
+    }
+
+    const auto* const type{type_spec()};
+
+    return {direction, type, identifier()};
+}
+
+ast::Member Parser::member()
+{
+    const auto* const type{type_spec()};
+
+    const auto mark{stack<ast::Declarator>().size()};
+
+    do
+    {
+        stack<ast::Declarator>().push_back(declarator());
+    } while (accept(Token_kind::Symbol_comma));
+
+    expect(Token_kind::Symbol_semicolon, "';'");
+
+    return {type, commit<ast::Declarator>(mark)};
+}
+
+ast::Declarator Parser::declarator()
+{
+    const auto name{identifier()};
+
+    const auto mark{stack<const ast::Expression*>().size()};
+
+    while (accept(Token_kind::Symbol_lbracket))
+    {
+        stack<const ast::Expression*>().push_back(expression());
+
+        expect(Token_kind::Symbol_rbracket, "']'");
+    }
+
+    return {name, commit<const ast::Expression*>(mark)};
+}
+
+const ast::Type_spec* Parser::type_spec()
+{
+    switch (current() ? current()->kind() : Token_kind::Symbol_semicolon)
+    {
+    case Token_kind::Keyword_short:
+        advance();
+        return primitive(ast::Primitive::Short);
+    case Token_kind::Keyword_long:
+        advance();
+        if (accept(Token_kind::Keyword_long))
+        {
+            return primitive(ast::Primitive::Long_long);
+        }
+        return primitive(accept(Token_kind::Keyword_double) ? ast::Primitive::Long_double : ast::Primitive::Long);
+    case Token_kind::Keyword_unsigned:
+        advance();
+        if (accept(Token_kind::Keyword_short))
+        {
+            return primitive(ast::Primitive::Unsigned_short);
+        }
+        expect(Token_kind::Keyword_long, "'short' or 'long'");
+        return primitive(
+                accept(Token_kind::Keyword_long) ? ast::Primitive::Unsigned_long_long : ast::Primitive::Unsigned_long);
+    case Token_kind::Keyword_float:
+        advance();
+        return primitive(ast::Primitive::Float);
+    case Token_kind::Keyword_double:
+        advance();
+        return primitive(ast::Primitive::Double);
+    case Token_kind::Keyword_boolean:
+        advance();
+        return primitive(ast::Primitive::Boolean);
+    case Token_kind::Keyword_char:
+        advance();
+        return primitive(ast::Primitive::Char);
+    case Token_kind::Keyword_wchar:
+        advance();
+        return primitive(ast::Primitive::Wide_char);
+    case Token_kind::Keyword_octet:
+        advance();
+        return primitive(ast::Primitive::Octet);
+    case Token_kind::Keyword_any:
+        advance();
+        return primitive(ast::Primitive::Any);
+    case Token_kind::Keyword_string:
+    case Token_kind::Keyword_wstring:
+    {
+        const auto kind{current()->kind() == Token_kind::Keyword_string ? ast::Type_kind::String
+                                                                         : ast::Type_kind::Wide_string};
+        advance();
+
+        const ast::Expression* bound{nullptr};
+
+        if (accept(Token_kind::Symbol_less))
+        {
+            bound = expression();
+
+            expect(Token_kind::Symbol_greater, "'>'");
+        }
+
+        return arena_.create<ast::Type_spec>(ast::Type_spec{.kind = kind, .bound = bound});
+    }
+    case Token_kind::Keyword_sequence:
+    {
+        advance();
+
+        expect(Token_kind::Symbol_less, "'<'");
+
+        const auto* const element{type_spec()};
+
+        const auto* const bound{accept(Token_kind::Symbol_comma) ? expression() : nullptr};
+
+        expect(Token_kind::Symbol_greater, "'>'");
+
+        return arena_.create<ast::Type_spec>(
+                ast::Type_spec{.kind = ast::Type_kind::Sequence, .element = element, .bound = bound});
+    }
+    case Token_kind::Identifier:
+    case Token_kind::Symbol_colon:
+        return arena_.create<ast::Type_spec>(ast::Type_spec{.kind = ast::Type_kind::Named, .name = scoped_name()});
+    default:
+        fail("a type");
+    }
+}
+
+const ast::Type_spec* Parser::primitive(const ast::Primitive primitive)
+{
+    // Primitive types carry no per-use data, so every use refers to one shared node instead of a fresh one.
+    static constexpr auto nodes{[]
+                                {
+                                    constexpr auto count{static_cast<std::size_t>(ast::Primitive::Void) + 1};
+
+                                    std::array<ast::Type_spec, count> nodes;
+
+                                    for (std::size_t index{0}; index < count; ++index)
+                                    {
+                                        nodes[index].primitive = static_cast<ast::Primitive>(index);
+                                    }
+
+                                    return nodes;
+                                }()};
+
+    return &nodes[static_cast<std::size_t>(primitive)];
+}
+
+ast::Scoped_name Parser::scoped_name()
+{
+    const auto mark{stack<std::string_view>().size()};
+
+    // A leading "::" refers to the global scope and is recorded as an empty first part.
+    if (accept(Token_kind::Symbol_colon))
+    {
+        expect(Token_kind::Symbol_colon, "':'");
+
+        stack<std::string_view>().push_back({});
+    }
+
+    stack<std::string_view>().push_back(identifier());
+
+    for (;;)
+    {
+        // A single ':' after a name ends it (e.g. a case label); only "::" continues it.
+        const auto following{reader_.peek(1)};
+
+        if (!check(Token_kind::Symbol_colon) || !following || !*following ||
+            following->value().kind() != Token_kind::Symbol_colon)
+        {
+            break;
+        }
+
+        advance();
+
+        advance();
+
+        stack<std::string_view>().push_back(identifier());
+    }
+
+    return {commit<std::string_view>(mark)};
+}
+
+const ast::Expression* Parser::expression()
+{
+    const auto* left{term()};
+
+    while (check(Token_kind::Operator_plus) || check(Token_kind::Operator_minus))
+    {
+        const auto op{current()->kind()};
+
+        advance();
+
+        const auto* const right{term()};
+
+        left = arena_.create<ast::Expression>(
+                ast::Expression{.kind = ast::Expression_kind::Binary, .op = op, .left = left, .right = right});
+    }
+
+    return left;
+}
+
+const ast::Expression* Parser::term()
+{
+    const auto* left{unary()};
+
+    while (check(Token_kind::Operator_asterisk) || check(Token_kind::Operator_slash))
+    {
+        const auto op{current()->kind()};
+
+        advance();
+
+        const auto* const right{unary()};
+
+        left = arena_.create<ast::Expression>(
+                ast::Expression{.kind = ast::Expression_kind::Binary, .op = op, .left = left, .right = right});
+    }
+
+    return left;
+}
+
+const ast::Expression* Parser::unary()
+{
+    if (check(Token_kind::Operator_plus) || check(Token_kind::Operator_minus))
+    {
+        const auto op{current()->kind()};
+
+        advance();
+
+        const auto* const operand{unary()};
+
+        return arena_.create<ast::Expression>(
+                ast::Expression{.kind = ast::Expression_kind::Unary, .op = op, .left = operand});
+    }
+
+    return primary();
+}
+
+const ast::Expression* Parser::primary()
+{
+    if (accept(Token_kind::Symbol_lparen))
+    {
+        const auto* const inner{expression()};
+
+        expect(Token_kind::Symbol_rparen, "')'");
+
+        return inner;
+    }
+
+    if (current() && is_literal(current()->kind()))
+    {
+        const auto token{*current()};
+
+        advance();
+
+        return arena_.create<ast::Expression>(
+                ast::Expression{.kind = ast::Expression_kind::Literal, .op = token.kind(), .text = token.lexeme()});
+    }
+
+    if (check(Token_kind::Identifier) || check(Token_kind::Symbol_colon))
+    {
+        return arena_.create<ast::Expression>(ast::Expression{
+                .kind = ast::Expression_kind::Name, .op = Token_kind::Identifier, .name = scoped_name()});
+    }
+
+    fail("an expression");
+}
+
+const Parser::Token_t* Parser::current()
+{
+    const auto* const token{reader_.current()};
+
+    if (token)
+    {
+        return token;
+    }
+
+    // End of input or a lexical error; only the error needs the full result.
+    const auto expected{reader_.peek()};
+
+    if (!expected)
+    {
+        const auto& error{expected.error()};
+
+        const auto* const lines{reader_.lines()};
+
+        const auto& location{reader_.location()};
+
+        throw Failure{{
+                .file = {},
+                .offset = error.position(),
+                .line = lines ? lines->line(error.position()) : location.line(),
+                .column = lines ? lines->column(error.position()) : location.column(),
+                .message = error.message()}};
+    }
+
+    return nullptr;
+}
+
+bool Parser::check(const Token_kind kind)
+{
+    const auto* const token{current()};
+
+    return token && token->kind() == kind;
+}
+
+bool Parser::accept(const Token_kind kind)
+{
+    return check(kind) && reader_.accept(kind);
+}
+
+Parser::Token_t Parser::expect(const Token_kind kind, const std::string_view what)
+{
+    if (!check(kind))
+    {
+        fail(what);
+    }
+
+    return *reader_.expect(kind);
+}
+
+std::string_view Parser::identifier()
+{
+    return expect(Token_kind::Identifier, "an identifier").lexeme();
+}
+
+void Parser::advance()
+{
+    if (const auto* const token{current()})
+    {
+        (void) reader_.accept(token->kind());
+    }
+}
+
+void Parser::fail(const std::string_view expected)
+{
+    const auto* const token{current()};
+
+    const auto& location{reader_.location()};
+
+    const auto length{token ? token->lexeme().size() : 0};
+
+    // The location is just past the token, with its column counted in the reader's unit.
+    const auto width{token ? Utf8::length(token->lexeme(), reader_.column_unit()) : 0};
+
+    std::string message{"expected "};
+
+    message.append(expected).append(", found ");
+
+    if (token)
+    {
+        message.append("'").append(token->lexeme()).append("'");
+    }
+    else
+    {
+        message.append("end of input");
+    }
+
+    throw Failure{{
+            .file = {},
+            .offset = location.offset() - length,
+            .line = location.line(),
+            .column = location.column() > width ? location.column() - width : 1,
+            .message = std::move(message)}};
+}
+
+} // namespace parser::idl
@@ -0,0 +1,302 @@
+#include "parser/idl/preprocessor.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <system_error>
+#include <utility>
+
+namespace parser::idl
+{
+std::size_t Translation_unit::size() const noexcept
+{
+    return size_;
+}
+
+bool Translation_unit::empty() const noexcept
+{
+    return size_ == 0;
+}
+
+Token_kind Translation_unit::kind(const std::size_t index) const noexcept
+{
+    const auto [segment, position]{locate(index)};
+
+    return segment->file->tape.kind(position);
+}
+
+std::string_view Translation_unit::lexeme(const std::size_t index) const noexcept
+{
+    const auto [segment, position]{locate(index)};
+
+    return segment->file->tape.lexeme(position);
+}
+
+Translation_unit::Token_t Translation_unit::token(const std::size_t index) const noexcept
+{
+    const auto [segment, position]{locate(index)};
+
+    return segment->file->tape.token(position);
+}
+
+const std::filesystem::path& Translation_unit::file(const std::size_t index) const noexcept
+{
+    return locate(index).first->file->path;
+}
+
+std::size_t Translation_unit::line(const std::size_t index) const noexcept
+{
+    const auto [segment, position]{locate(index)};
+
+    return segment->file->tape.line(position);
+}
+
+std::size_t Translation_unit::column(const std::size_t index) const noexcept
+{
+    const auto [segment, position]{locate(index)};
+
+    return segment->file->tape.column(position);
+}
+
+std::span<const Translation_unit::Segment> Translation_unit::segments() const noexcept
+{
+    return segments_;
+}
+
+Parser::Result_t Translation_unit::parse(Token_reader& reader, Arena& arena) const
+{
+    // Where the text of every segment starts in the loaded text and in its own file.
+    std::vector<std::size_t> text_starts;
+
+    std::vector<std::size_t> source_starts;
+
+    std::string text;
+
+    for (const auto& segment : segments_)
+    {
+        const auto& tape{segment.file->tape};
+
+        const auto begin{tape.offset(segment.first)};
+
+        const auto end{tape.offset(segment.last - 1) + tape.length(segment.last - 1)};
+
+        text_starts.push_back(text.size());
+
+        source_starts.push_back(begin);
+
+        text.append(tape.source().substr(begin, end - begin)).push_back('\n');
+    }
+
+    reader.load(std::move(text));
+
+    Parser parser{reader, arena};
+
+    auto result{parser.parse()};
+
+    if (result || segments_.empty())
+    {
+        return result;
+    }
+
+    auto diagnostic{std::move(result.error())};
+
+    const auto index{
+            static_cast<std::size_t>(std::ranges::upper_bound(text_starts, diagnostic.offset) - text_starts.begin())};
+
+    const auto& segment{segments_[index - 1]};
+
+    const auto& tape{segment.file->tape};
+
+    const auto end{tape.offset(segment.last - 1) + tape.length(segment.last - 1)};
+
+    // Positions on the separator after a segment (e.g. the end of input) belong to the end of that segment.
+    const auto offset{std::min(source_starts[index - 1] + diagnostic.offset - text_starts[index - 1], end)};
+
+    diagnostic.file = segment.file->path;
+
+    diagnostic.offset = offset;
+
+    diagnostic.line = tape.lines().line(offset);
+
+    diagnostic.column = tape.lines().column(offset);
+
+    return std::unexpected(std::move(diagnostic));
+}
+
+std::vector<Source_location> Translation_unit::locations(Source_manager& manager) const
+{
+    std::map<const Source_file*, File_id> files;
+
+    std::vector<Source_location> result;
+
+    result.reserve(size_);
+
+    for (const auto& segment : segments_)
+    {
+        const auto& tape{segment.file->tape};
+
+        auto [entry, inserted]{files.try_emplace(segment.file.get(), no_file)};
+
+        if (inserted)
+        {
+            entry->second = manager.add(segment.file->path, tape.source());
+        }
+
+        for (auto position{segment.first}; position < segment.last; ++position)
+        {
+            result.push_back(manager.location(entry->second, tape.offset(position)));
+        }
+    }
+
+    return result;
+}
+
+void Translation_unit::append(
+        const std::shared_ptr<const Source_file>& file, const std::size_t first, const std::size_t last)
+{
+    if (first < last)
+    {
+        starts_.push_back(size_);
+
+        segments_.push_back({file, first, last});
+
+        size_ += last - first;
+    }
+}
+
+std::pair<const Translation_unit::Segment*, std::size_t> Translation_unit::locate(
+        const std::size_t index) const noexcept
+{
+    const auto segment{static_cast<std::size_t>(std::ranges::upper_bound(starts_, index) - starts_.begin()) - 1};
+
+    return {&segments_[segment], segments_[segment].first + index - starts_[segment]};
+}
+
+Preprocessor::Preprocessor(std::vector<std::filesystem::path> search_paths, Source_cache& cache)
+    : search_paths_{std::move(search_paths)}, cache_{cache}
+{}
+
+Preprocessor::Result_t Preprocessor::run(const std::filesystem::path& file)
+{
+    once_.clear();
+
+    guards_.clear();
+
+    const auto root{cache_.load(file)};
+
+    if (!root)
+    {
+        return std::unexpected(root.error());
+    }
+
+    if ((*root)->pragma_once)
+    {
+        once_.insert((*root)->path);
+    }
+
+    if (!(*root)->guard.empty())
+    {
+        guards_.insert((*root)->guard);
+    }
+
+    Translation_unit unit;
+
+    if (auto failure{expand(*root, unit, 0)})
+    {
+        return std::unexpected(std::move(*failure));
+    }
+
+    return unit;
+}
+
+std::optional<Diagnostic> Preprocessor::expand(
+        const std::shared_ptr<const Source_file>& file, Translation_unit& unit, const std::size_t depth)
+{
+    std::size_t position{0};
+
+    for (const auto& include : file->includes)
+    {
+        unit.append(file, position, include.token);
+
+        position = include.token;
+
+        const auto failure{[&file, &include](std::string message) {
+            return Diagnostic{.file = file->path, .line = include.line, .message = std::move(message)};
+        }};
+
+        const auto path{resolve(*file, include)};
+
+        if (path.empty())
+        {
+            return failure("cannot find included file '" + include.target + "'");
+        }
+
+        const auto loaded{cache_.load(path)};
+
+        if (!loaded)
+        {
+            return loaded.error();
+        }
+
+        const auto& header{*loaded};
+
+        if (once_.contains(header->path) || (!header->guard.empty() && guards_.contains(header->guard)))
+        {
+            continue;
+        }
+
+        if (depth + 1 >= max_depth)
+        {
+            return failure("includes nested too deeply, probably a cycle through '" + include.target + "'");
+        }
+
+        if (header->pragma_once)
+        {
+            once_.insert(header->path);
+        }
+
+        if (!header->guard.empty())
+        {
+            guards_.insert(header->guard);
+        }
+
+        if (auto nested{expand(header, unit, depth + 1)})
+        {
+            return nested;
+        }
+    }
+
+    unit.append(file, position, file->tape.size());
+
+    return std::nullopt;
+}
+
+std::filesystem::path Preprocessor::resolve(const Source_file& includer, const Include_directive& include) const
+{
+    const auto exists{[](const std::filesystem::path& candidate)
+                      {
+                          std::error_code error;
+
+                          return std::filesystem::is_regular_file(candidate, error);
+                      }};
+
+    if (!include.angled)
+    {
+        if (auto candidate{includer.path.parent_path() / include.target}; exists(candidate))
+        {
+            return candidate;
+        }
+    }
+
+    for (const auto& directory : search_paths_)
+    {
+        if (auto candidate{directory / include.target}; exists(candidate))
+        {
+            return candidate;
+        }
+    }
+
+    return {};
+}
+
+} // namespace parser::idl
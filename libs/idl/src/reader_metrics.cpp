@@ -0,0 +1,43 @@
+#include "parser/idl/reader_metrics.hpp"
+
+#include <numeric>
+
+namespace parser::idl
+{
+uint64_t Reader_metrics::count(const Token_kind kind) const noexcept
+{
+    return tokens[static_cast<std::size_t>(kind)];
+}
+
+uint64_t Reader_metrics::total() const noexcept
+{
+    return std::accumulate(tokens.begin(), tokens.end(), uint64_t{0});
+}
+
+Reader_metrics& Reader_metrics::operator+=(const Reader_metrics& other) noexcept
+{
+    for (std::size_t kind = 0; kind < kinds; ++kind)
+    {
+        tokens[kind] += other.tokens[kind];
+    }
+
+    skipped += other.skipped;
+
+    bytes_normalized += other.bytes_normalized;
+
+    carriage_returns += other.carriage_returns;
+
+    peek_hits += other.peek_hits;
+
+    tokenizer_calls += other.tokenizer_calls;
+
+    lexical_errors += other.lexical_errors;
+
+    tokenizer_cycles += other.tokenizer_cycles;
+
+    location_cycles += other.location_cycles;
+
+    return *this;
+}
+
+} // namespace parser::idl
@@ -0,0 +1,94 @@
+#include "parser/idl/shifted_offsets.hpp"
+
+#include <algorithm>
+
+namespace parser::idl
+{
+std::size_t Shifted_offsets::size() const noexcept
+{
+    return values_.size();
+}
+
+bool Shifted_offsets::empty() const noexcept
+{
+    return values_.empty();
+}
+
+std::size_t Shifted_offsets::operator[](const std::size_t index) const noexcept
+{
+    return index < from_ ? values_[index] : values_[index] + delta_;
+}
+
+std::size_t Shifted_offsets::upper_bound(const std::size_t offset) const noexcept
+{
+    const auto split{delta_ == 0 ? values_.end() : values_.begin() + static_cast<std::ptrdiff_t>(from_)};
+
+    auto found{std::upper_bound(values_.begin(), split, offset)};
+
+    if (found == split && split != values_.end())
+    {
+        // Stored values plus the shift, in modular arithmetic, are the true offsets.
+        found = std::upper_bound(
+                split, values_.end(), offset, [this](const std::size_t key, const std::size_t value) {
+                    return key < value + delta_;
+                });
+    }
+
+    return static_cast<std::size_t>(found - values_.begin());
+}
+
+std::vector<std::size_t>& Shifted_offsets::values() noexcept
+{
+    settle(values_.size());
+
+    return values_;
+}
+
+void Shifted_offsets::splice(
+        const std::size_t first, const std::size_t last, const std::span<const std::size_t> inserted,
+        const std::size_t delta)
+{
+    settle(last);
+
+    const auto removed{last - first};
+
+    const auto common{std::min(removed, inserted.size())};
+
+    const auto begin{values_.begin() + static_cast<std::ptrdiff_t>(first)};
+
+    // Overwrite in place and only move the tail when the number of entries changes.
+    std::copy_n(inserted.begin(), common, begin);
+
+    if (removed > common)
+    {
+        values_.erase(begin + static_cast<std::ptrdiff_t>(common), begin + static_cast<std::ptrdiff_t>(removed));
+    }
+    else
+    {
+        values_.insert(begin + static_cast<std::ptrdiff_t>(common), inserted.begin() + common, inserted.end());
+    }
+
+    from_ = first + inserted.size();
+
+    delta_ += delta;
+}
+
+void Shifted_offsets::settle(const std::size_t index) noexcept
+{
+    if (delta_ != 0)
+    {
+        for (auto entry{from_}; entry < index; ++entry)
+        {
+            values_[entry] += delta_;
+        }
+
+        for (auto entry{index}; entry < from_; ++entry)
+        {
+            values_[entry] -= delta_;
+        }
+    }
+
+    from_ = index;
+}
+
+} // namespace parser::idl
@@ -0,0 +1,378 @@
+#include "parser/idl/source_cache.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <exception>
+#include <iterator>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+#include "parser/idl/lexer_factory.hpp"
+#include "parser/idl/newline_normalizer.hpp"
+#include "parser/idl/source_scanner.hpp"
+#include "parser/idl/token_reader.hpp"
+
+namespace parser::idl
+{
+namespace
+{
+/**
+ * A directive line: the word after '#' and the rest of the line.
+ */
+struct Directive
+{
+    std::string name;
+
+    std::string argument;
+
+    std::size_t offset;
+
+    std::size_t line;
+
+    std::size_t column;
+
+    std::size_t token{0};
+};
+
+std::string_view trim(std::string_view text) noexcept
+{
+    const auto first{text.find_first_not_of(" \t")};
+
+    if (first == std::string_view::npos)
+    {
+        return {};
+    }
+
+    return text.substr(first, text.find_last_not_of(" \t") - first + 1);
+}
+
+std::string_view first_word(const std::string_view text) noexcept
+{
+    const auto trimmed{trim(text)};
+
+    return trimmed.substr(0, trimmed.find_first_of(" \t"));
+}
+
+/**
+ * Collect the directive lines of `text` and overwrite them with spaces, keeping newlines and offsets. Only lines
+ * starting outside block comments count, and string literals and comments are skipped while looking for line
+ * starts, so a '#' in a comment or literal is left alone.
+ */
+std::vector<Directive> extract_directives(std::string& text)
+{
+    std::vector<Directive> directives;
+
+    std::size_t line{1};
+
+    bool line_start{true};
+
+    for (std::size_t position{0}; position < text.size();)
+    {
+        if (line_start)
+        {
+            line_start = false;
+
+            const auto end{Source_scanner::line_comment_end(text, position)};
+
+            const std::string_view content{text.data() + position, end - position};
+
+            if (const auto hash{content.find_first_not_of(" \t")};
+                hash != std::string_view::npos && content[hash] == '#')
+            {
+                const auto rest{trim(content.substr(hash + 1))};
+
+                const auto name{rest.substr(0, rest.find_first_of(" \t"))};
+
+                directives.push_back(
+                        {.name = std::string{name},
+                         .argument = std::string{trim(rest.substr(name.size()))},
+                         .offset = position + hash,
+                         .line = line,
+                         .column = hash + 1});
+
+                text.replace(position, end - position, end - position, ' ');
+
+                position = end;
+
+                continue;
+            }
+        }
+
+        const std::string_view view{text};
+
+        const auto character{view[position]};
+
+        if (character == '\n')
+        {
+            ++line;
+
+            line_start = true;
+
+            ++position;
+        }
+        else if (character == '"')
+        {
+            // An unclosed literal is the lexer's error to report; stop skipping at the end of its line.
+            const auto end{Source_scanner::string_end(view, position)};
+
+            position = end == std::string_view::npos ? Source_scanner::line_comment_end(view, position) : end;
+        }
+        else if (view.substr(position, 2) == "//")
+        {
+            position = Source_scanner::line_comment_end(view, position);
+        }
+        else if (view.substr(position, 2) == "/*")
+        {
+            const auto end{std::min(Source_scanner::comment_end(view, position), view.size())};
+
+            line += static_cast<std::size_t>(std::count(view.begin() + position, view.begin() + end, '\n'));
+
+            position = end;
+        }
+        else
+        {
+            ++position;
+        }
+    }
+
+    return directives;
+}
+
+/**
+ * Index of the first token of `tape` starting at or after `offset`.
+ */
+std::size_t first_token_at(const Token_tape& tape, const std::size_t offset) noexcept
+{
+    std::size_t low{0};
+
+    for (auto high{tape.size()}; low < high;)
+    {
+        const auto middle{low + (high - low) / 2};
+
+        if (tape.offset(middle) < offset)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+Diagnostic error(const Source_file& file, const Directive& directive, std::string message)
+{
+    return {.file = file.path,
+            .offset = directive.offset,
+            .line = directive.line,
+            .column = directive.column,
+            .message = std::move(message)};
+}
+
+/**
+ * Fill the include list, `#pragma once` and the include guard of `file` from its directives.
+ */
+std::optional<Diagnostic> interpret(Source_file& file, const std::vector<Directive>& directives)
+{
+    std::vector<const Directive*> conditionals;
+
+    for (const auto& directive : directives)
+    {
+        if (directive.name == "include")
+        {
+            const std::string_view argument{directive.argument};
+
+            const auto angled{argument.starts_with('<')};
+
+            const auto close{argument.find(angled ? '>' : '"', 1)};
+
+            if ((!angled && !argument.starts_with('"')) || close == std::string_view::npos || close == 1)
+            {
+                return error(file, directive, "expected \"file\" or <file> after #include");
+            }
+
+            file.includes.push_back(
+                    {.target = std::string{argument.substr(1, close - 1)},
+                     .angled = angled,
+                     .line = directive.line,
+                     .token = directive.token});
+        }
+        else if (directive.name == "pragma")
+        {
+            file.pragma_once = file.pragma_once || first_word(directive.argument) == "once";
+        }
+        else if (directive.name == "ifndef" || directive.name == "define" || directive.name == "endif")
+        {
+            conditionals.push_back(&directive);
+        }
+        else
+        {
+            return error(file, directive, "unsupported preprocessor directive '#" + directive.name + "'");
+        }
+    }
+
+    if (conditionals.empty())
+    {
+        return std::nullopt;
+    }
+
+    const auto guard{first_word(conditionals.front()->argument)};
+
+    const auto is_guard{
+            conditionals.size() == 3 && conditionals[0]->name == "ifndef" && conditionals[1]->name == "define" &&
+            conditionals[2]->name == "endif" && !guard.empty() && first_word(conditionals[1]->argument) == guard &&
+            conditionals[1]->token == 0 && conditionals[2]->token == file.tape.size()};
+
+    if (!is_guard)
+    {
+        return error(
+                file, *conditionals.front(),
+                "unsupported use of '#" + conditionals.front()->name + "': only include guards are supported");
+    }
+
+    file.guard = guard;
+
+    return std::nullopt;
+}
+
+} // namespace
+
+Source_cache::Source_cache(std::shared_ptr<const lexer::core::Lexer> lexer) : lexer_{std::move(lexer)}
+{}
+
+Source_cache& Source_cache::global()
+{
+    static Source_cache cache{std::make_shared<const lexer::core::Lexer>(Lexer_factory::build())};
+
+    return cache;
+}
+
+Source_cache::Result_t Source_cache::load(const std::filesystem::path& file)
+{
+    std::error_code error;
+
+    auto canonical{std::filesystem::canonical(file, error)};
+
+    const auto modified{
+            error ? std::filesystem::file_time_type{} : std::filesystem::last_write_time(canonical, error)};
+
+    if (error)
+    {
+        return std::unexpected(Diagnostic{.file = file, .message = "cannot open file: " + file.string()});
+    }
+
+    std::promise<Result_t> promise;
+
+    std::shared_future<Result_t> result;
+
+    bool loading{false};
+    {
+        const std::lock_guard lock{mutex_};
+
+        auto& entry{entries_[canonical]};
+
+        if (entry.result.valid() && entry.modified == modified)
+        {
+            result = entry.result;
+        }
+        else
+        {
+            entry = {modified, promise.get_future().share()};
+
+            result = entry.result;
+
+            loading = true;
+        }
+    }
+
+    // This call inserted the entry, so it loads the file; callers arriving meanwhile wait on the shared future.
+    if (loading)
+    {
+        try
+        {
+            promise.set_value(read(canonical, modified));
+        }
+        catch (...)
+        {
+            promise.set_exception(std::current_exception());
+        }
+    }
+
+    return result.get();
+}
+
+std::size_t Source_cache::size() const
+{
+    const std::lock_guard lock{mutex_};
+
+    return entries_.size();
+}
+
+void Source_cache::clear()
+{
+    const std::lock_guard lock{mutex_};
+
+    entries_.clear();
+}
+
+Source_cache::Result_t Source_cache::read(
+        const std::filesystem::path& canonical, const std::filesystem::file_time_type modified) const
+{
+    std::ifstream stream{canonical, std::ios::binary};
+
+    if (!stream.is_open())
+    {
+        return std::unexpected(Diagnostic{.file = canonical, .message = "cannot open file: " + canonical.string()});
+    }
+
+    std::string text{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+
+    Newline_normalizer::normalize(text);
+
+    auto directives{extract_directives(text)};
+
+    Token_reader reader{lexer_, Location_mode::Lazy};
+
+    reader.load(std::move(text));
+
+    auto tape{reader.tape()};
+
+    if (!tape)
+    {
+        const auto position{tape.error().position()};
+
+        return std::unexpected(Diagnostic{
+                .file = canonical,
+                .offset = position,
+                .line = reader.lines()->line(position),
+                .column = reader.lines()->column(position),
+                .message = tape.error().message()});
+    }
+
+    tape->detach();
+
+    auto file{std::make_shared<Source_file>()};
+
+    file->path = canonical;
+
+    file->modified = modified;
+
+    file->tape = std::move(*tape);
+
+    for (auto& directive : directives)
+    {
+        directive.token = first_token_at(file->tape, directive.offset);
+    }
+
+    if (auto failure{interpret(*file, directives)})
+    {
+        return std::unexpected(std::move(*failure));
+    }
+
+    return file;
+}
+
+} // namespace parser::idl
@@ -0,0 +1,100 @@
+#include "parser/idl/source_manager.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace parser::idl
+{
+File_id Source_manager::add(std::filesystem::path name, const std::string_view text)
+{
+    const auto available{std::numeric_limits<uint32_t>::max() - next_};
+
+    if (text.size() >= available || entries_.size() >= no_file)
+    {
+        throw std::length_error("Source_manager: location space exhausted by " + name.string());
+    }
+
+    const auto size{static_cast<uint32_t>(text.size())};
+
+    starts_.push_back(next_);
+
+    entries_.push_back({std::move(name), size, Line_index{text}});
+
+    next_ += size + 1;
+
+    return static_cast<File_id>(entries_.size() - 1);
+}
+
+Source_location Source_manager::location(const File_id file, const std::size_t offset) const noexcept
+{
+    if (file >= entries_.size())
+    {
+        return {};
+    }
+
+    const auto clamped{static_cast<uint32_t>(std::min<std::size_t>(offset, entries_[file].size))};
+
+    return Source_location::from_raw(starts_[file]).advanced(clamped);
+}
+
+File_id Source_manager::file(const Source_location location) const noexcept
+{
+    if (!location.valid() || location.raw() >= next_)
+    {
+        return no_file;
+    }
+
+    const auto after{std::ranges::upper_bound(starts_, location.raw())};
+
+    return static_cast<File_id>(after - starts_.begin() - 1);
+}
+
+Source_manager::Decoded Source_manager::decode(const Source_location location) const noexcept
+{
+    const auto id{file(location)};
+
+    if (id == no_file)
+    {
+        return {};
+    }
+
+    const auto offset{static_cast<std::size_t>(location.raw() - starts_[id])};
+
+    const auto& lines{entries_[id].lines};
+
+    return {.file = id, .offset = offset, .line = lines.line(offset), .column = lines.column(offset)};
+}
+
+Diagnostic Source_manager::diagnostic(const Source_location location, std::string message) const
+{
+    const auto decoded{decode(location)};
+
+    if (decoded.file == no_file)
+    {
+        return {.file = {}, .message = std::move(message)};
+    }
+
+    return {.file = entries_[decoded.file].name,
+            .offset = decoded.offset,
+            .line = decoded.line,
+            .column = decoded.column,
+            .message = std::move(message)};
+}
+
+const std::filesystem::path& Source_manager::name(const File_id file) const noexcept
+{
+    return entries_[file].name;
+}
+
+std::size_t Source_manager::size(const File_id file) const noexcept
+{
+    return entries_[file].size;
+}
+
+std::size_t Source_manager::files() const noexcept
+{
+    return entries_.size();
+}
+
+} // namespace parser::idl
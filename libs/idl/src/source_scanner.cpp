@@ -0,0 +1,61 @@
+#include "parser/idl/source_scanner.hpp"
+
+#include <algorithm>
+
+namespace parser::idl
+{
+namespace
+{
+/**
+ * Returns true for the characters the lexer's literal and comment patterns accept: printable ASCII and the bytes
+ * of non-ASCII UTF-8 sequences.
+ */
+bool is_printable(const char character) noexcept
+{
+    return (character >= ' ' && character <= '~') || static_cast<unsigned char>(character) >= 0x80;
+}
+
+/**
+ * Returns true for the characters a block comment accepts besides printable ones.
+ */
+bool is_escape(const char character) noexcept
+{
+    return character == '\t' || character == '\n' || character == '\v' || character == '\f' || character == '\r';
+}
+
+} // namespace
+
+std::size_t Source_scanner::string_end(const std::string_view text, const std::size_t position) noexcept
+{
+    auto run{position + 1};
+
+    while (run < text.size() && is_printable(text[run]))
+    {
+        ++run;
+    }
+
+    const auto close{text.substr(0, run).rfind('"')};
+
+    return close > position ? close + 1 : std::string_view::npos;
+}
+
+std::size_t Source_scanner::comment_end(const std::string_view text, const std::size_t position) noexcept
+{
+    auto run{position + 2};
+
+    while (run < text.size() && (is_printable(text[run]) || is_escape(text[run])))
+    {
+        ++run;
+    }
+
+    const auto close{text.substr(0, run).rfind("*/")};
+
+    return close != std::string_view::npos && close >= position + 2 ? close + 2 : std::string_view::npos;
+}
+
+std::size_t Source_scanner::line_comment_end(const std::string_view text, const std::size_t position) noexcept
+{
+    return std::min(text.find('\n', position), text.size());
+}
+
+} // namespace parser::idl
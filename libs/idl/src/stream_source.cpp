@@ -0,0 +1,152 @@
+#include "parser/idl/stream_source.hpp"
+
+#include <cerrno>
+#include <stdexcept>
+#include <unistd.h>
+
+#include "parser/idl/newline_normalizer.hpp"
+
+namespace parser::idl
+{
+Stream_source::Stream_source(std::istream& stream, const std::size_t chunk_size)
+    : stream_{&stream}, descriptor_{-1}, chunk_size_{chunk_size}
+{
+    if (chunk_size_ == 0)
+    {
+        throw std::invalid_argument("Stream_source: chunk size must not be zero");
+    }
+}
+
+Stream_source::Stream_source(const int descriptor, const std::size_t chunk_size)
+    : stream_{nullptr}, descriptor_{descriptor}, chunk_size_{chunk_size}
+{
+    if (chunk_size_ == 0)
+    {
+        throw std::invalid_argument("Stream_source: chunk size must not be zero");
+    }
+}
+
+std::optional<std::string> Stream_source::window(const std::size_t consumed)
+{
+    buffer_.erase(0, consumed);
+
+    const auto handed{window_ - consumed};
+
+    for (;;)
+    {
+        if (end_)
+        {
+            window_ = buffer_.size();
+
+            break;
+        }
+
+        if (const auto newline{buffer_.rfind('\n')}; newline != std::string::npos && newline >= handed)
+        {
+            window_ = newline + 1;
+
+            break;
+        }
+
+        fill();
+    }
+
+    if (window_ == 0)
+    {
+        return std::nullopt;
+    }
+
+    return buffer_.substr(0, window_);
+}
+
+std::optional<std::string> Stream_source::rest(const std::size_t consumed)
+{
+    buffer_.erase(0, consumed);
+
+    while (!end_)
+    {
+        fill();
+    }
+
+    window_ = buffer_.size();
+
+    if (window_ == 0)
+    {
+        return std::nullopt;
+    }
+
+    return buffer_;
+}
+
+bool Stream_source::exhausted() const noexcept
+{
+    return end_ && window_ == buffer_.size();
+}
+
+bool Stream_source::opens_comment(const std::size_t offset) const noexcept
+{
+    return offset + 1 < window_ && buffer_[offset] == '/' && buffer_[offset + 1] == '*';
+}
+
+std::size_t Stream_source::buffered() const noexcept
+{
+    return buffer_.size() + chunk_.size();
+}
+
+void Stream_source::fill()
+{
+    chunk_.assign(carriage_return_ ? 1 : 0, '\r');
+
+    const auto base{chunk_.size()};
+
+    chunk_.resize(base + chunk_size_);
+
+    const auto count{read(chunk_.data() + base, chunk_size_)};
+
+    chunk_.resize(base + count);
+
+    end_ = count == 0;
+
+    carriage_return_ = !end_ && chunk_.back() == '\r';
+
+    if (carriage_return_)
+    {
+        chunk_.pop_back();
+    }
+
+    Newline_normalizer::normalize(chunk_);
+
+    buffer_ += chunk_;
+
+    chunk_.clear();
+}
+
+std::size_t Stream_source::read(char* const data, const std::size_t size)
+{
+    if (stream_)
+    {
+        stream_->read(data, static_cast<std::streamsize>(size));
+
+        if (stream_->bad())
+        {
+            throw std::runtime_error("Stream_source: cannot read input stream");
+        }
+
+        return static_cast<std::size_t>(stream_->gcount());
+    }
+
+    for (;;)
+    {
+        if (const auto count{::read(descriptor_, data, size)}; count >= 0)
+        {
+            return static_cast<std::size_t>(count);
+        }
+
+        if (errno != EINTR)
+        {
+            throw std::runtime_error("Stream_source: cannot read file descriptor");
+        }
+    }
+}
+
+} // namespace parser::idl
@@ -0,0 +1,115 @@
+#include "parser/idl/symbol_table.hpp"
+
+#include <functional>
+#include <stdexcept>
+
+namespace parser::idl
+{
+namespace
+{
+constexpr std::size_t initial_slots{64};
+
+} // namespace
+
+Symbol_table::Symbol_table(const std::span<const std::string_view> seeds) : slots_(initial_slots, no_symbol)
+{
+    for (const auto name : well_known_symbols)
+    {
+        intern(name);
+    }
+
+    for (const auto name : seeds)
+    {
+        intern(name);
+    }
+}
+
+Symbol_id Symbol_table::intern(const std::string_view name)
+{
+    const auto hash{std::hash<std::string_view>{}(name)};
+
+    const auto slot{probe(name, hash)};
+
+    if (slots_[slot] != no_symbol)
+    {
+        return slots_[slot];
+    }
+
+    if (spellings_.size() == no_symbol)
+    {
+        throw std::length_error("Symbol_table: too many symbols");
+    }
+
+    const auto symbol{static_cast<Symbol_id>(spellings_.size())};
+
+    const auto stored{arena_.copy(std::span<const char>{name})};
+
+    spellings_.emplace_back(stored.data(), stored.size());
+
+    hashes_.push_back(hash);
+
+    slots_[slot] = symbol;
+
+    // Keep the load factor at or below one half so probe sequences stay short.
+    if (spellings_.size() * 2 > slots_.size())
+    {
+        grow();
+    }
+
+    return symbol;
+}
+
+std::optional<Symbol_id> Symbol_table::find(const std::string_view name) const noexcept
+{
+    const auto symbol{slots_[probe(name, std::hash<std::string_view>{}(name))]};
+
+    return symbol == no_symbol ? std::nullopt : std::optional{symbol};
+}
+
+std::string_view Symbol_table::spelling(const Symbol_id symbol) const noexcept
+{
+    return spellings_[symbol];
+}
+
+std::size_t Symbol_table::size() const noexcept
+{
+    return spellings_.size();
+}
+
+std::size_t Symbol_table::probe(const std::string_view name, const std::size_t hash) const noexcept
+{
+    const auto mask{slots_.size() - 1};
+
+    for (auto slot{hash & mask};; slot = (slot + 1) & mask)
+    {
+        const auto symbol{slots_[slot]};
+
+        if (symbol == no_symbol || (hashes_[symbol] == hash && spellings_[symbol] == name))
+        {
+            return slot;
+        }
+    }
+}
+
+void Symbol_table::grow()
+{
+    std::vector<Symbol_id> slots(slots_.size() * 2, no_symbol);
+
+    const auto mask{slots.size() - 1};
+
+    for (Symbol_id symbol{0}; symbol < spellings_.size(); ++symbol)
+    {
+        auto slot{hashes_[symbol] & mask};
+
+        while (slots[slot] != no_symbol)
+        {
+            slot = (slot + 1) & mask;
+        }
+
+        slots[slot] = symbol;
+    }
+
+    slots_ = std::move(slots);
+}
+
+} // namespace parser::idl
@@ -0,0 +1,60 @@
+#include "parser/idl/tape_cursor.hpp"
+
+#include <algorithm>
+
+namespace parser::idl
+{
+Tape_cursor::Tape_cursor(const Token_tape& tape) noexcept : tape_{&tape}, position_{0}
+{}
+
+std::optional<Tape_cursor::Token_t> Tape_cursor::peek(const std::size_t n) const noexcept
+{
+    if (position_ + n >= tape_->size())
+    {
+        return std::nullopt;
+    }
+
+    return tape_->token(position_ + n);
+}
+
+std::optional<Token_kind> Tape_cursor::kind(const std::size_t n) const noexcept
+{
+    if (position_ + n >= tape_->size())
+    {
+        return std::nullopt;
+    }
+
+    return tape_->kind(position_ + n);
+}
+
+std::optional<Tape_cursor::Token_t> Tape_cursor::next() noexcept
+{
+    if (at_end())
+    {
+        return std::nullopt;
+    }
+
+    return tape_->token(position_++);
+}
+
+std::size_t Tape_cursor::position() const noexcept
+{
+    return position_;
+}
+
+void Tape_cursor::seek(const std::size_t position) noexcept
+{
+    position_ = std::min(position, tape_->size());
+}
+
+bool Tape_cursor::at_end() const noexcept
+{
+    return position_ >= tape_->size();
+}
+
+const Token_tape& Tape_cursor::tape() const noexcept
+{
+    return *tape_;
+}
+
+} // namespace parser::idl
@@ -0,0 +1,164 @@
+#include "parser/idl/thread_pool.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace parser::idl
+{
+Thread_pool::Thread_pool(const std::size_t threads)
+{
+    const auto count{std::max<std::size_t>(threads, 1)};
+
+    for (std::size_t worker = 0; worker < count; ++worker)
+    {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+
+    for (std::size_t worker = 0; worker < count; ++worker)
+    {
+        threads_.emplace_back([this, worker] { work(worker); });
+    }
+}
+
+Thread_pool::~Thread_pool()
+{
+    {
+        const std::lock_guard lock{mutex_};
+
+        stop_ = true;
+    }
+
+    wake_.notify_all();
+}
+
+std::size_t Thread_pool::size() const noexcept
+{
+    return queues_.size();
+}
+
+void Thread_pool::run(const std::span<const std::size_t> order, const Task_t& task)
+{
+    if (order.empty())
+    {
+        return;
+    }
+
+    std::unique_lock lock{mutex_};
+
+    for (std::size_t index = 0; index < order.size(); ++index)
+    {
+        auto& queue{*queues_[index % queues_.size()]};
+
+        const std::lock_guard queue_lock{queue.mutex};
+
+        queue.tasks.push_back(order[index]);
+    }
+
+    task_ = &task;
+
+    active_ = queues_.size();
+
+    ++generation_;
+
+    wake_.notify_all();
+
+    done_.wait(lock, [this] { return active_ == 0; });
+
+    task_ = nullptr;
+
+    if (error_)
+    {
+        std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+}
+
+std::size_t Thread_pool::default_threads() noexcept
+{
+    return std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+void Thread_pool::work(const std::size_t worker)
+{
+    std::size_t seen{0};
+
+    for (;;)
+    {
+        const Task_t* task{nullptr};
+        {
+            std::unique_lock lock{mutex_};
+
+            wake_.wait(lock, [this, seen] { return stop_ || generation_ != seen; });
+
+            if (stop_)
+            {
+                return;
+            }
+
+            seen = generation_;
+
+            task = task_;
+        }
+
+        for (std::size_t index; pop(worker, index);)
+        {
+            try
+            {
+                (*task)(index, worker);
+            }
+            catch (...)
+            {
+                const std::lock_guard lock{mutex_};
+
+                if (!error_)
+                {
+                    error_ = std::current_exception();
+                }
+            }
+        }
+
+        const std::lock_guard lock{mutex_};
+
+        if (--active_ == 0)
+        {
+            done_.notify_one();
+        }
+    }
+}
+
+bool Thread_pool::pop(const std::size_t worker, std::size_t& task)
+{
+    {
+        auto& own{*queues_[worker]};
+
+        const std::lock_guard lock{own.mutex};
+
+        if (!own.tasks.empty())
+        {
+            task = own.tasks.front();
+
+            own.tasks.pop_front();
+
+            return true;
+        }
+    }
+
+    for (std::size_t step = 1; step < queues_.size(); ++step)
+    {
+        auto& victim{*queues_[(worker + step) % queues_.size()]};
+
+        const std::lock_guard lock{victim.mutex};
+
+        if (!victim.tasks.empty())
+        {
+            task = victim.tasks.back();
+
+            victim.tasks.pop_back();
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} // namespace parser::idl
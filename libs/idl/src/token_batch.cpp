@@ -0,0 +1,162 @@
+#include "parser/idl/token_batch.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <numeric>
+#include <optional>
+#include <system_error>
+
+namespace parser::idl
+{
+Token_batch::Token_batch(lexer::core::Lexer lexer, const std::size_t threads)
+    : Token_batch{std::make_shared<const lexer::core::Lexer>(std::move(lexer)), threads}
+{}
+
+Token_batch::Token_batch(std::shared_ptr<const lexer::core::Lexer> lexer, const std::size_t threads)
+    : lexer_{std::move(lexer)}, pool_{threads}, readers_(pool_.size())
+{}
+
+std::vector<Token_batch::Result_t> Token_batch::tokenize(const std::span<const std::filesystem::path> files)
+{
+    std::vector<std::optional<Result_t>> slots(files.size());
+
+    const auto order{schedule(files)};
+
+    metrics_.assign(Reader_metrics::enabled ? files.size() : 0, Reader_metrics{});
+
+    pool_.run(order, [this, files, &slots](const std::size_t index, const std::size_t worker) {
+        auto& reader{this->reader(worker)};
+
+        const auto& file{files[index]};
+
+        reader.reset_metrics();
+
+        if (symbols_)
+        {
+            reader.attach_symbols(*symbols_);
+        }
+        else
+        {
+            reader.detach_symbols();
+        }
+
+        // Anything thrown for one file (unreadable input, a tape over 4 GiB, exhausted memory) is reported in that
+        // file's slot; letting it reach the pool would discard the results of every other file.
+        try
+        {
+            reader.load(file);
+
+            auto tape{reader.tape()};
+
+            if constexpr (Reader_metrics::enabled)
+            {
+                metrics_[index] = reader.metrics();
+            }
+
+            if (!tape)
+            {
+                const auto& error{tape.error()};
+
+                const auto* lines{reader.lines()};
+
+                slots[index].emplace(std::unexpected(Diagnostic{
+                        .file = file,
+                        .offset = error.position(),
+                        .line = lines->line(error.position()),
+                        .column = lines->column(error.position()),
+                        .message = error.message()}));
+
+                return;
+            }
+
+            tape->detach();
+
+            slots[index].emplace(std::move(*tape));
+        }
+        catch (const std::exception& error)
+        {
+            slots[index].emplace(std::unexpected(Diagnostic{.file = file, .message = error.what()}));
+        }
+    });
+
+    std::vector<Result_t> results;
+
+    results.reserve(files.size());
+
+    for (auto& slot : slots)
+    {
+        results.push_back(std::move(*slot));
+    }
+
+    return results;
+}
+
+void Token_batch::attach_symbols(Concurrent_symbol_table& symbols) noexcept
+{
+    symbols_ = &symbols;
+}
+
+void Token_batch::detach_symbols() noexcept
+{
+    symbols_ = nullptr;
+}
+
+Reader_metrics Token_batch::metrics(const std::size_t index) const noexcept
+{
+    return index < metrics_.size() ? metrics_[index] : Reader_metrics{};
+}
+
+Reader_metrics Token_batch::metrics() const noexcept
+{
+    Reader_metrics total;
+
+    for (const auto& metrics : metrics_)
+    {
+        total += metrics;
+    }
+
+    return total;
+}
+
+std::size_t Token_batch::threads() const noexcept
+{
+    return pool_.size();
+}
+
+std::vector<std::size_t> Token_batch::schedule(const std::span<const std::filesystem::path> files)
+{
+    std::vector<std::uintmax_t> sizes;
+
+    sizes.reserve(files.size());
+
+    for (const auto& file : files)
+    {
+        std::error_code error;
+
+        const auto size{std::filesystem::file_size(file, error)};
+
+        sizes.push_back(error ? 0 : size);
+    }
+
+    std::vector<std::size_t> order(files.size());
+
+    std::iota(order.begin(), order.end(), 0);
+
+    std::ranges::stable_sort(order, std::ranges::greater{}, [&sizes](const std::size_t index) { return sizes[index]; });
+
+    return order;
+}
+
+Token_reader& Token_batch::reader(const std::size_t worker)
+{
+    auto& reader{readers_[worker]};
+
+    if (!reader)
+    {
+        reader = std::make_unique<Token_reader>(lexer_, Location_mode::Lazy);
+    }
+
+    return *reader;
+}
+
+} // namespace parser::idl
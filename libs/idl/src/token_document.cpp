@@ -0,0 +1,344 @@
+#include "parser/idl/token_document.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "parser/idl/keywords.hpp"
+
+namespace parser::idl
+{
+namespace
+{
+/**
+ * Replace `[first, last)` of `values` with `inserted`, moving the tail at most once.
+ */
+template <typename T>
+void splice(std::vector<T>& values, const std::size_t first, const std::size_t last, const std::vector<T>& inserted)
+{
+    const auto removed{last - first};
+
+    const auto common{std::min(removed, inserted.size())};
+
+    const auto begin{values.begin() + static_cast<std::ptrdiff_t>(first)};
+
+    std::copy_n(inserted.begin(), common, begin);
+
+    if (removed > common)
+    {
+        values.erase(begin + static_cast<std::ptrdiff_t>(common), begin + static_cast<std::ptrdiff_t>(removed));
+    }
+    else
+    {
+        values.insert(begin + static_cast<std::ptrdiff_t>(common), inserted.begin() + common, inserted.end());
+    }
+}
+
+} // namespace
+
+Token_document::Token_document(lexer::core::Lexer lexer) : tokenizer_{std::move(lexer)}
+{}
+
+Token_document::Token_document(lexer::core::Lexer lexer, std::string text) : Token_document{std::move(lexer)}
+{
+    (void) load(std::move(text));
+}
+
+Token_document::Edit_result_t Token_document::load(std::string text)
+{
+    text_ = std::move(text);
+
+    lines_.build(text_);
+
+    closing_ = text_.rfind("*/");
+
+    return relex(0, 0, text_.size(), 0, false);
+}
+
+Token_document::Edit_result_t Token_document::replace(
+        const std::size_t offset, const std::size_t length, const std::string_view text)
+{
+    if (offset > text_.size() || length > text_.size() - offset)
+    {
+        throw std::out_of_range("Token_document: edit range is outside the text");
+    }
+
+    const auto resync{!touches_comment(offset, length, text)};
+
+    std::size_t first{0};
+
+    std::size_t start{0};
+
+    if (resync && !kinds_.empty())
+    {
+        // Tokens are only known up to a lexical error, so an edit past it restarts on the error's line.
+        const auto restart{std::min(offset, lexed_)};
+
+        const auto newline{restart == 0 ? std::string::npos : text_.rfind('\n', restart - 1)};
+
+        const auto probe{newline == std::string::npos ? 0 : newline};
+
+        first = offsets_.upper_bound(probe) - 1;
+
+        start = offsets_[first];
+    }
+
+    text_.replace(offset, length, text);
+
+    lines_.replace(offset, length, text);
+
+    // Track the last comment terminator through the edit rather than searching the whole text for it.
+    if (closing_ != std::string::npos && closing_ >= offset + length)
+    {
+        closing_ = closing_ - length + text.size();
+    }
+    else
+    {
+        const auto from{offset == 0 ? 0 : offset - 1};
+
+        const auto found{std::string_view{text_}.substr(from, offset + text.size() + 1 - from).rfind("*/")};
+
+        if (found != std::string_view::npos)
+        {
+            closing_ = from + found;
+        }
+        else if (closing_ != std::string::npos && closing_ + 2 > offset)
+        {
+            // The edit broke the terminator, which also makes the edit re-lex the whole text.
+            closing_ = text_.rfind("*/", offset);
+        }
+    }
+
+    const auto delta{static_cast<std::ptrdiff_t>(text.size()) - static_cast<std::ptrdiff_t>(length)};
+
+    return relex(first, start, offset + text.size(), delta, resync);
+}
+
+const std::string& Token_document::text() const noexcept
+{
+    return text_;
+}
+
+std::size_t Token_document::size() const noexcept
+{
+    return kinds_.size();
+}
+
+Token_kind Token_document::kind(const std::size_t index) const noexcept
+{
+    return kinds_[index];
+}
+
+std::size_t Token_document::offset(const std::size_t index) const noexcept
+{
+    return offsets_[index];
+}
+
+std::size_t Token_document::length(const std::size_t index) const noexcept
+{
+    return (index + 1 < offsets_.size() ? offsets_[index + 1] : lexed_) - offsets_[index];
+}
+
+std::string_view Token_document::lexeme(const std::size_t index) const noexcept
+{
+    return std::string_view{text_}.substr(offset(index), length(index));
+}
+
+Token_document::Token_t Token_document::token(const std::size_t index) const noexcept
+{
+    return {kinds_[index], lexeme(index)};
+}
+
+std::size_t Token_document::line(const std::size_t index) const noexcept
+{
+    return lines_.line(offsets_[index]);
+}
+
+std::size_t Token_document::column(const std::size_t index) const noexcept
+{
+    return lines_.column(offsets_[index]);
+}
+
+std::size_t Token_document::lexed() const noexcept
+{
+    return lexed_;
+}
+
+const std::optional<Token_document::Error_t>& Token_document::error() const noexcept
+{
+    return error_;
+}
+
+Token_document::Edit_result_t Token_document::relex(
+        const std::size_t first, const std::size_t start, const std::size_t edit_end, const std::ptrdiff_t delta,
+        const bool resync)
+{
+    const auto old_size{kinds_.size()};
+
+    std::vector<Token_kind> kinds;
+
+    std::vector<std::size_t> offsets;
+
+    std::optional<Error_t> error;
+
+    auto last{old_size};
+
+    auto position{start};
+
+    // True if an old token boundary maps to `position`, leaving in `last` the index of the first reusable token.
+    auto resynchronized{[&, probe{first}]() mutable
+                              {
+                                  if (!resync || position < edit_end)
+                                  {
+                                      return false;
+                                  }
+
+                                  const auto old_position{
+                                          static_cast<std::size_t>(static_cast<std::ptrdiff_t>(position) - delta)};
+
+                                  while (probe < old_size && offsets_[probe] < old_position)
+                                  {
+                                      ++probe;
+                                  }
+
+                                  last = probe;
+
+                                  return probe < old_size ? offsets_[probe] == old_position
+                                                          : !error_ && lexed_ == old_position;
+                              }};
+
+    // A block comment may run up to the last terminator in the text, so one opening before it is only lexed from a
+    // window reaching that far.
+    const auto comment_end{closing_ == std::string::npos ? 0 : closing_ + 2};
+
+    bool reused{false};
+
+    bool done{false};
+
+    for (auto target{std::max(edit_end, start)}; !done;)
+    {
+        const auto window_end{line_end(target)};
+
+        const auto last_window{window_end == text_.size()};
+
+        const auto window_start{position};
+
+        tokenizer_.load(text_.substr(window_start, window_end - window_start));
+
+        target = window_end + (window_end - start);
+
+        for (;;)
+        {
+            if (resynchronized())
+            {
+                reused = done = true;
+
+                break;
+            }
+
+            const auto expected{tokenizer_.next<Token_kind>()};
+
+            if (window_end < comment_end && text_.compare(position, 2, "/*") == 0)
+            {
+                target = std::max(target, comment_end);
+
+                break;
+            }
+
+            if (!expected)
+            {
+                // The tokenizer reports positions within the window.
+                error.emplace(expected.error().message(), window_start + expected.error().position());
+
+                done = true;
+
+                break;
+            }
+
+            const auto& optional{expected.value()};
+
+            if (!optional)
+            {
+                done = last_window;
+
+                break;
+            }
+
+            const auto& token{optional.value()};
+
+            const auto end{position + token.lexeme().size()};
+
+            // The window may have cut this token short: lex it again from a longer one.
+            if (!last_window && end == window_end)
+            {
+                break;
+            }
+
+            kinds.push_back(Keywords::resolve(token.kind(), token.lexeme()));
+
+            offsets.push_back(position);
+
+            position = end;
+        }
+    }
+
+    if (!reused)
+    {
+        last = old_size;
+    }
+
+    splice(kinds_, first, last, kinds);
+
+    // Reused tokens are shifted lazily, so an edit does not touch every token after it.
+    offsets_.splice(first, last, offsets, static_cast<std::size_t>(delta));
+
+    if (reused)
+    {
+        lexed_ = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(lexed_) + delta);
+
+        if (error_)
+        {
+            error_.emplace(error_->message(), error_->position() + static_cast<std::size_t>(delta));
+        }
+    }
+    else
+    {
+        lexed_ = position;
+
+        error_ = std::move(error);
+    }
+
+    if (error_ && !reused)
+    {
+        return std::unexpected(*error_);
+    }
+
+    return Token_edit{first, last - first, kinds.size()};
+}
+
+bool Token_document::touches_comment(const std::size_t offset, const std::size_t length, const std::string_view text) const
+{
+    const auto delimits{[](const std::string_view span)
+                        { return span.find("/*") != std::string_view::npos || span.find("*/") != std::string_view::npos; }};
+
+    const auto before{offset > 0 ? 1UL : 0UL};
+
+    const auto after{offset + length < text_.size() ? 1UL : 0UL};
+
+    std::string joined{text_, offset - before, before};
+
+    joined += text;
+
+    joined.append(text_, offset + length, after);
+
+    return delimits(std::string_view{text_}.substr(offset - before, before + length + after)) || delimits(joined);
+}
+
+std::size_t Token_document::line_end(const std::size_t offset) const noexcept
+{
+    const auto newline{text_.find('\n', offset)};
+
+    return newline == std::string::npos ? text_.size() : newline + 1;
+}
+
+} // namespace parser::idl
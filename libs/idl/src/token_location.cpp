@@ -4,17 +4,48 @@
 
 namespace parser::idl
 {
-Token_location::Token_location() : line_{1}, column_{1}, offset_{0}
+namespace
+{
+/**
+ * Returns true for tokens whose text may contain non-ASCII characters.
+ */
+bool may_hold_non_ascii(const Token_kind kind) noexcept
+{
+    return kind == Token_kind::String_literal || kind == Token_kind::Character_literal ||
+           kind == Token_kind::Single_line_comment || kind == Token_kind::Multi_line_comment;
+}
+
+/**
+ * Number of columns `text`, a part of a token of kind `kind`, spans in `unit`.
+ */
+std::size_t width(const Column_unit unit, const Token_kind kind, const std::string_view text) noexcept
+{
+    return unit == Column_unit::Bytes || !may_hold_non_ascii(kind) ? text.size() : Utf8::length(text, unit);
+}
+
+} // namespace
+
+Token_location::Token_location() : line_{1}, column_{1}, offset_{0}, index_{nullptr}
 {}
 
 std::size_t Token_location::line() const noexcept
 {
-    return line_;
+    return index_ ? index_->line(offset_) : line_;
 }
 
 std::size_t Token_location::column() const noexcept
 {
-    return column_;
+    if (!index_)
+    {
+        return column_;
+    }
+
+    if (unit_ == Column_unit::Bytes || !input_)
+    {
+        return index_->column(offset_);
+    }
+
+    return index_->column(offset_, {input_, offset_}, unit_);
 }
 
 std::size_t Token_location::offset() const noexcept
@@ -22,20 +53,59 @@ std::size_t Token_location::offset() const noexcept
     return offset_;
 }
 
+Column_unit Token_location::column_unit() const noexcept
+{
+    return unit_;
+}
+
+void Token_location::set_column_unit(const Column_unit unit) noexcept
+{
+    unit_ = unit;
+}
+
 void Token_location::reset() noexcept
 {
-    *this = Token_location{};
+    line_ = 1;
+
+    column_ = 1;
+
+    offset_ = 0;
+
+    input_ = nullptr;
+}
+
+void Token_location::attach(const Line_index* index) noexcept
+{
+    index_ = index;
 }
 
 void Token_location::advance(const Token_kind kind, const std::string_view lexeme) noexcept
 {
-    if (kind == Token_kind::Newline || kind == Token_kind::Multi_line_comment)
+    if (index_)
+    {
+        offset_ += lexeme.size();
+
+        if (unit_ != Column_unit::Bytes)
+        {
+            input_ = lexeme.data() + lexeme.size() - offset_;
+        }
+
+        return;
+    }
+
+    const auto last{
+            kind == Token_kind::Newline || kind == Token_kind::Multi_line_comment ? lexeme.rfind('\n')
+                                                                                   : std::string_view::npos};
+
+    if (last != std::string_view::npos)
     {
-        std::ranges::for_each(lexeme, [this](const char c) { column_ = c == '\n' ? (++line_, 1) : column_ + 1; });
+        line_ += static_cast<std::size_t>(std::ranges::count(lexeme, '\n'));
+
+        column_ = 1 + width(unit_, kind, lexeme.substr(last + 1));
     }
     else
     {
-        column_ += lexeme.size();
+        column_ += width(unit_, kind, lexeme);
     }
 
     offset_ += lexeme.size();
@@ -6,31 +6,119 @@ namespace parser::idl
 {
 const std::optional<Token_lookahead::Token_t>& Token_lookahead::token() const noexcept
 {
-    return token_;
+    return token(0);
+}
+
+const std::optional<Token_lookahead::Token_t>& Token_lookahead::token(const std::size_t n) const noexcept
+{
+    static const std::optional<Token_t> empty;
+
+    return n < size_ ? slot(n).token : empty;
 }
 
 const Token_location& Token_lookahead::location() const noexcept
 {
-    return location_;
+    return location(0);
+}
+
+const Token_location& Token_lookahead::location(const std::size_t n) const noexcept
+{
+    return n < size_ ? slot(n).location : location_;
+}
+
+Symbol_id Token_lookahead::symbol(const std::size_t n) const noexcept
+{
+    return n < size_ ? slot(n).symbol : no_symbol;
+}
+
+std::size_t Token_lookahead::size() const noexcept
+{
+    return size_;
 }
 
 std::optional<Token_lookahead::Token_t> Token_lookahead::consume() noexcept
 {
-    return std::exchange(token_, std::nullopt);
+    if (size_ == 0)
+    {
+        return std::nullopt;
+    }
+
+    auto token{std::exchange(slots_[head_].token, std::nullopt)};
+
+    head_ = (head_ + 1) % capacity;
+
+    --size_;
+
+    return token;
+}
+
+void Token_lookahead::pop() noexcept
+{
+    if (size_ > 0)
+    {
+        head_ = (head_ + 1) % capacity;
+
+        --size_;
+    }
 }
 
 void Token_lookahead::reset() noexcept
 {
-    token_.reset();
+    for (auto& slot : slots_)
+    {
+        slot.token.reset();
+    }
+
+    head_ = 0;
+
+    size_ = 0;
 
     location_.reset();
 }
 
-void Token_lookahead::advance(Token_kind kind, std::string_view lexeme) noexcept
+void Token_lookahead::attach(const Line_index* index) noexcept
+{
+    location_.attach(index);
+
+    for (auto& slot : slots_)
+    {
+        slot.location.attach(index);
+    }
+}
+
+void Token_lookahead::set_column_unit(const Column_unit unit) noexcept
 {
-    token_.emplace(kind, lexeme);
+    location_.set_column_unit(unit);
 
+    for (auto& slot : slots_)
+    {
+        slot.location.set_column_unit(unit);
+    }
+}
+
+void Token_lookahead::advance(const Token_kind kind, const std::string_view lexeme, const Symbol_id symbol) noexcept
+{
     location_.advance(kind, lexeme);
+
+    auto& slot{slots_[(head_ + size_) % capacity]};
+
+    slot.token.emplace(kind, lexeme);
+
+    slot.location = location_;
+
+    slot.symbol = symbol;
+
+    ++size_;
+}
+
+void Token_lookahead::skip(const Token_kind kind, const std::string_view lexeme) noexcept
+{
+    location_.advance(kind, lexeme);
+}
+
+const Token_lookahead::Slot& Token_lookahead::slot(const std::size_t n) const noexcept
+{
+    return slots_[(head_ + n) % capacity];
 }
 
 } // namespace parser::idl
@@ -0,0 +1,30 @@
+#include "parser/idl/token_range.hpp"
+
+namespace parser::idl
+{
+Token_range::Token_range(Token_reader& reader) noexcept : reader_{&reader}
+{}
+
+Token_range::Iterator Token_range::begin() const noexcept
+{
+    return Iterator{*reader_};
+}
+
+std::default_sentinel_t Token_range::end() noexcept
+{
+    return std::default_sentinel;
+}
+
+std::optional<Token_range::Error_t> Token_range::error() const
+{
+    const auto expected{reader_->peek()};
+
+    if (expected)
+    {
+        return std::nullopt;
+    }
+
+    return expected.error();
+}
+
+} // namespace parser::idl
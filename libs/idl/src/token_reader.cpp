@@ -1,134 +1,726 @@
 #include "parser/idl/token_reader.hpp"
 
+#include <algorithm>
 #include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "parser/idl/keywords.hpp"
+#include "parser/idl/mapped_file.hpp"
+#include "parser/idl/newline_normalizer.hpp"
 
 namespace parser::idl
 {
-Token_reader::Token_reader(lexer::core::Lexer lexer) : tokenizer_{std::move(lexer)}
-{}
+Token_reader::Token_reader(lexer::core::Lexer lexer, const Location_mode mode)
+    : tokenizer_{std::move(lexer)}
+    , line_index_{mode == Location_mode::Lazy ? std::make_unique<Line_index>() : nullptr}
+{
+    lookahead_.attach(line_index_.get());
+}
 
-Token_reader::Token_reader(lexer::core::Lexer lexer, const std::string& input)
-    : tokenizer_{std::move(lexer), normalize(input)}
+Token_reader::Token_reader(const std::shared_ptr<const lexer::core::Lexer>& lexer, const Location_mode mode)
+    : Token_reader{lexer::core::Lexer{*lexer}, mode}
 {}
 
-Token_reader::Token_reader(lexer::core::Lexer lexer, const std::filesystem::path& file)
-    : tokenizer_{std::move(lexer), normalize(file)}
-{}
+Token_reader::Token_reader(lexer::core::Lexer lexer, const std::string& input, const Location_mode mode)
+    : Token_reader{std::move(lexer), mode}
+{
+    load(input);
+}
+
+Token_reader::Token_reader(lexer::core::Lexer lexer, std::string&& input, const Location_mode mode)
+    : Token_reader{std::move(lexer), mode}
+{
+    load(std::move(input));
+}
+
+Token_reader::Token_reader(lexer::core::Lexer lexer, const std::string_view input, const Location_mode mode)
+    : Token_reader{std::move(lexer), mode}
+{
+    load(input);
+}
+
+Token_reader::Token_reader(lexer::core::Lexer lexer, const std::filesystem::path& file, const Location_mode mode)
+    : Token_reader{std::move(lexer), mode}
+{
+    load(file);
+}
+
+Token_reader::Token_reader(lexer::core::Lexer lexer, Stream_source source, const Location_mode mode)
+    : Token_reader{std::move(lexer), mode}
+{
+    load(std::move(source));
+}
 
 void Token_reader::load(const std::string& input)
 {
-    tokenizer_.load(normalize(input));
+    install(normalize(input));
+}
 
-    lookahead_.reset();
+void Token_reader::load(std::string&& input)
+{
+    install(normalize(std::move(input)));
+}
+
+void Token_reader::load(const std::string_view input)
+{
+    install(normalize(input));
+}
+
+void Token_reader::load(const std::span<const char> input)
+{
+    load(std::string_view{input.data(), input.size()});
 }
 
 void Token_reader::load(const std::filesystem::path& file)
 {
-    tokenizer_.load(normalize(file));
+    install(normalize(file));
+}
 
-    lookahead_.reset();
+void Token_reader::load(Stream_source source)
+{
+    install({});
+
+    lookahead_.attach(nullptr);
+
+    stream_.emplace(std::move(source));
 }
 
 void Token_reader::reset() noexcept
 {
+    if (stream_)
+    {
+        stream_.reset();
+
+        tokenizer_.load({});
+
+        pinned_.clear();
+
+        consumed_ = 0;
+
+        window_start_ = 0;
+    }
+
     tokenizer_.reset();
 
     lookahead_.reset();
+
+    drop_checkpoints();
+
+    comments_.clear();
+
+    lexed_ = 0;
 }
 
 Token_reader::Result_t Token_reader::peek()
 {
-    if (lookahead_.token())
+    return peek(0);
+}
+
+Token_reader::Result_t Token_reader::peek(const std::size_t n)
+{
+    if (n >= Token_lookahead::capacity)
+    {
+        throw std::out_of_range("Token_reader: lookahead depth exceeds capacity: " + std::to_string(n));
+    }
+
+    const auto replayed{replaying()};
+
+    if (n < replayed)
+    {
+        metrics_.peek_hit();
+
+        return history_[replay_ + n].token;
+    }
+
+    const auto depth{n - replayed};
+
+    if (depth < lookahead_.size())
+    {
+        metrics_.peek_hit();
+    }
+
+    if (auto stop{fill(depth)})
+    {
+        return std::move(*stop);
+    }
+
+    return lookahead_.token(depth);
+}
+
+Token_reader::Result_t Token_reader::next()
+{
+    if (replaying() > 0)
     {
-        return lookahead_.token();
+        auto token{history_[replay_++].token};
+
+        trim();
+
+        return token;
     }
 
+    const auto expected{peek()};
+
+    if (!expected)
+    {
+        return expected;
+    }
+
+    if (const auto& optional{expected.value()}; !optional)
+    {
+        return std::nullopt;
+    }
+
+    if (marks_ > 0)
+    {
+        history_.push_back({*lookahead_.token(), lookahead_.location(), lookahead_.symbol(0)});
+
+        replay_ = history_.size();
+    }
+
+    return lookahead_.consume();
+}
+
+const Token_reader::Token_t* Token_reader::current()
+{
+    if (replaying() > 0)
+    {
+        metrics_.peek_hit();
+
+        return &history_[replay_].token;
+    }
+
+    if (lookahead_.size() > 0)
+    {
+        metrics_.peek_hit();
+    }
+    else if (fill(0))
+    {
+        return nullptr;
+    }
+
+    return &*lookahead_.token();
+}
+
+bool Token_reader::check(const Token_kind kind)
+{
+    const auto* const token{current()};
+
+    return token && token->kind() == kind;
+}
+
+bool Token_reader::accept(const Token_kind kind)
+{
+    if (!check(kind))
+    {
+        return false;
+    }
+
+    consume();
+
+    return true;
+}
+
+std::optional<Token_reader::Token_t> Token_reader::expect(const Token_kind kind)
+{
+    const auto* const token{current()};
+
+    if (!token || token->kind() != kind)
+    {
+        return std::nullopt;
+    }
+
+    std::optional<Token_t> expected{*token};
+
+    consume();
+
+    return expected;
+}
+
+Token_reader::Checkpoint Token_reader::mark()
+{
+    ++marks_;
+
+    return Checkpoint{replay_, generation_};
+}
+
+void Token_reader::rewind(const Checkpoint& checkpoint) noexcept
+{
+    if (checkpoint.generation_ != generation_)
+    {
+        return;
+    }
+
+    replay_ = checkpoint.position_;
+
+    release(checkpoint);
+}
+
+void Token_reader::release(const Checkpoint& checkpoint) noexcept
+{
+    if (checkpoint.generation_ != generation_)
+    {
+        return;
+    }
+
+    --marks_;
+
+    trim();
+}
+
+Token_reader::Tape_result_t Token_reader::tape()
+{
+    if (stream_)
+    {
+        throw std::logic_error("Token_reader: cannot build a token tape from streamed input");
+    }
+
+    reset();
+
+    Token_tape tape;
+
+    const char* source{nullptr};
+
+    std::size_t offset{0};
+
     for (;;)
     {
-        const auto expected{tokenizer_.next<Token_kind>()};
+        const auto expected{tokenize()};
 
         if (!expected)
         {
-            return expected;
+            metrics_.error();
+
+            reset();
+
+            return std::unexpected(expected.error());
         }
 
         const auto& optional{expected.value()};
 
         if (!optional)
         {
-            return std::nullopt;
+            break;
         }
 
         const auto& token{optional.value()};
 
-        lookahead_.advance(token.kind(), token.lexeme());
+        const auto lexeme{token.lexeme()};
+
+        if (!source)
+        {
+            source = lexeme.data();
+        }
 
-        if (skip_token(token.kind()))
+        if (offset + lexeme.size() > std::numeric_limits<uint32_t>::max())
         {
-            lookahead_.consume();
+            reset();
 
-            continue;
+            throw std::length_error("Token_reader: input too large for a token tape");
         }
 
-        return lookahead_.token();
+        const auto kind{classify(token)};
+
+        metrics_.token(kind);
+
+        if (skip_token(kind))
+        {
+            metrics_.skipped();
+        }
+        else if (symbols_ || shared_symbols_)
+        {
+            tape.push(kind, offset, lexeme.size(), intern(kind, lexeme));
+        }
+        else
+        {
+            tape.push(kind, offset, lexeme.size());
+        }
+
+        offset += lexeme.size();
     }
+
+    tape.finish({source, offset});
+
+    reset();
+
+    return tape;
 }
 
-Token_reader::Result_t Token_reader::next()
+const Token_location& Token_reader::location() const noexcept
 {
-    const auto expected{peek()};
+    return location(0);
+}
 
-    if (!expected)
-    {
-        return expected;
-    }
+const Token_location& Token_reader::location(const std::size_t n) const noexcept
+{
+    const auto replayed{replaying()};
 
-    if (const auto& optional{expected.value()}; !optional)
-    {
-        return std::nullopt;
-    }
+    return n < replayed ? history_[replay_ + n].location : lookahead_.location(n - replayed);
+}
 
-    return lookahead_.consume();
+const Line_index* Token_reader::lines() const noexcept
+{
+    return stream_ ? nullptr : line_index_.get();
 }
 
-const Token_location& Token_reader::location() const noexcept
+void Token_reader::set_column_unit(const Column_unit unit) noexcept
 {
-    return lookahead_.location();
+    lookahead_.set_column_unit(unit);
 }
 
-bool Token_reader::skip_token(const Token_kind kind) noexcept
+Column_unit Token_reader::column_unit() const noexcept
 {
-    return kind == Token_kind::Whitespace || kind == Token_kind::Newline;
+    return lookahead_.location().column_unit();
 }
 
-std::string Token_reader::normalize(const std::string& input)
+void Token_reader::set_trivia(const Trivia_policy& policy) noexcept
+{
+    trivia_ = policy;
+}
+
+const Trivia_policy& Token_reader::trivia() const noexcept
 {
-    std::string output;
+    return trivia_;
+}
+
+const Comment_table& Token_reader::comments() const noexcept
+{
+    return comments_;
+}
+
+void Token_reader::attach_symbols(Symbol_table& symbols) noexcept
+{
+    symbols_ = &symbols;
+
+    shared_symbols_ = nullptr;
+}
+
+void Token_reader::attach_symbols(Concurrent_symbol_table& symbols) noexcept
+{
+    symbols_ = nullptr;
+
+    shared_symbols_ = &symbols;
+}
+
+void Token_reader::detach_symbols() noexcept
+{
+    symbols_ = nullptr;
+
+    shared_symbols_ = nullptr;
+}
+
+Symbol_id Token_reader::symbol(const std::size_t n) const noexcept
+{
+    const auto replayed{replaying()};
+
+    return n < replayed ? history_[replay_ + n].symbol : lookahead_.symbol(n - replayed);
+}
+
+Reader_metrics Token_reader::metrics() const noexcept
+{
+    return metrics_.snapshot();
+}
+
+void Token_reader::reset_metrics() noexcept
+{
+    metrics_.reset();
+}
+
+Token_reader::Result_t Token_reader::lex()
+{
+    if (!stream_)
+    {
+        return tokenize();
+    }
+
+    for (;;)
+    {
+        auto expected{tokenize()};
+
+        if (stream_->exhausted())
+        {
+            return expected;
+        }
+
+        // A block comment matches up to the last terminator in the input, which is only known once all of it was
+        // read, so one is lexed again from a window reaching the end.
+        const auto comment{stream_->opens_comment(consumed_)};
+
+        if (expected && expected.value())
+        {
+            if (!comment)
+            {
+                consumed_ += expected.value()->lexeme().size();
+
+                return expected;
+            }
+        }
+        else if (!expected && !comment)
+        {
+            return expected;
+        }
 
-    output.reserve(input.size());
+        pin();
 
-    for (auto iterator = input.cbegin(); iterator != input.cend();)
+        auto window{comment ? stream_->rest(consumed_) : stream_->window(consumed_)};
+
+        window_start_ += consumed_;
+
+        consumed_ = 0;
+
+        if (!window)
+        {
+            tokenizer_.load({});
+
+            return std::nullopt;
+        }
+
+        tokenizer_.load(std::move(*window));
+    }
+}
+
+Token_reader::Result_t Token_reader::tokenize()
+{
+    const auto start{metrics_.now()};
+
+    auto expected{tokenizer_.next<Token_kind>()};
+
+    metrics_.tokenizer(start);
+
+    return expected;
+}
+
+std::optional<Token_reader::Result_t> Token_reader::fill(const std::size_t depth)
+{
+    while (lookahead_.size() <= depth)
     {
-        if (const char c = *iterator++; c == '\r')
+        const auto expected{lex()};
+
+        if (!expected)
         {
-            if (iterator != input.cend() && *iterator == '\n')
+            metrics_.error();
+
+            if (stream_)
             {
-                ++iterator;
+                // The tokenizer only sees the current window; report the position in the whole input.
+                const auto& error{expected.error()};
+
+                return std::unexpected(Error_t{error.message(), window_start_ + error.position()});
             }
 
-            output.push_back('\n');
+            return expected;
         }
-        else
+
+        const auto& optional{expected.value()};
+
+        if (!optional)
         {
-            output.push_back(c);
+            return Result_t{std::nullopt};
         }
+
+        const auto& token{optional.value()};
+
+        const auto kind{classify(token)};
+
+        metrics_.token(kind);
+
+        const auto start{metrics_.now()};
+
+        if (skip_token(kind))
+        {
+            lookahead_.skip(kind, token.lexeme());
+
+            metrics_.location(start);
+
+            metrics_.skipped();
+
+            if (trivia_.record_comments && comment_trivia.contains(kind))
+            {
+                comments_.add(lexed_, token.lexeme());
+            }
+
+            continue;
+        }
+
+        lookahead_.advance(kind, token.lexeme(), intern(kind, token.lexeme()));
+
+        metrics_.location(start);
+
+        ++lexed_;
     }
 
-    return output;
+    return std::nullopt;
+}
+
+void Token_reader::consume()
+{
+    if (replaying() > 0)
+    {
+        ++replay_;
+
+        trim();
+
+        return;
+    }
+
+    if (marks_ > 0)
+    {
+        history_.push_back({*lookahead_.token(), lookahead_.location(), lookahead_.symbol(0)});
+
+        replay_ = history_.size();
+    }
+
+    lookahead_.pop();
+}
+
+void Token_reader::pin()
+{
+    std::size_t size{0};
+
+    const auto measure{[&size](const Token_t& token) { size += token.lexeme().size(); }};
+
+    lookahead_.for_each(measure);
+
+    for (const auto& retained : history_)
+    {
+        measure(retained.token);
+    }
+
+    std::vector<char> pinned(size);
+
+    std::size_t used{0};
+
+    const auto relocate{[&pinned, &used](Token_t& token)
+                        {
+                            const auto lexeme{token.lexeme()};
+
+                            std::ranges::copy(lexeme, pinned.data() + used);
+
+                            token = Token_t{token.kind(), {pinned.data() + used, lexeme.size()}};
+
+                            used += lexeme.size();
+                        }};
+
+    lookahead_.for_each(relocate);
+
+    for (auto& retained : history_)
+    {
+        relocate(retained.token);
+    }
+
+    pinned_ = std::move(pinned);
+}
+
+std::size_t Token_reader::replaying() const noexcept
+{
+    return history_.size() - replay_;
+}
+
+void Token_reader::trim() noexcept
+{
+    if (marks_ == 0 && replaying() == 0)
+    {
+        history_.clear();
+
+        replay_ = 0;
+    }
+}
+
+void Token_reader::drop_checkpoints() noexcept
+{
+    history_.clear();
+
+    replay_ = 0;
+
+    marks_ = 0;
+
+    ++generation_;
+}
+
+void Token_reader::install(std::string input)
+{
+    stream_.reset();
+
+    drop_checkpoints();
+
+    pinned_.clear();
+
+    consumed_ = 0;
+
+    window_start_ = 0;
+
+    comments_.clear();
+
+    lexed_ = 0;
+
+    lookahead_.attach(line_index_.get());
+
+    if (line_index_)
+    {
+        line_index_->build(input);
+    }
+
+    tokenizer_.load(std::move(input));
+
+    lookahead_.reset();
+}
+
+Token_kind Token_reader::classify(const Token_t& token) noexcept
+{
+    return Keywords::resolve(token.kind(), token.lexeme());
+}
+
+Symbol_id Token_reader::intern(const Token_kind kind, const std::string_view lexeme)
+{
+    if (kind != Token_kind::Identifier)
+    {
+        return no_symbol;
+    }
+
+    if (symbols_)
+    {
+        return symbols_->intern(lexeme);
+    }
+
+    return shared_symbols_ ? shared_symbols_->intern(lexeme) : no_symbol;
+}
+
+bool Token_reader::skip_token(const Token_kind kind) const noexcept
+{
+    return trivia_.skip.contains(kind);
+}
+
+std::string Token_reader::normalize(const std::string& input)
+{
+    return normalize(std::string_view{input});
+}
+
+std::string Token_reader::normalize(const std::string_view input)
+{
+    metrics_.normalized(input);
+
+    return Newline_normalizer::normalize(input);
+}
+
+std::string Token_reader::normalize(std::string&& input) noexcept
+{
+    metrics_.normalized(input);
+
+    Newline_normalizer::normalize(input);
+
+    return std::move(input);
 }
 
 std::string Token_reader::normalize(const std::filesystem::path& file)
 {
+    if (std::error_code error; std::filesystem::is_regular_file(file, error))
+    {
+        const Mapped_file mapped{file};
+
+        return normalize(mapped.view());
+    }
+
     return normalize(read(file));
 }
 
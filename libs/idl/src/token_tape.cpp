@@ -0,0 +1,112 @@
+#include "parser/idl/token_tape.hpp"
+
+namespace parser::idl
+{
+std::size_t Token_tape::size() const noexcept
+{
+    return kinds_.size();
+}
+
+bool Token_tape::empty() const noexcept
+{
+    return kinds_.empty();
+}
+
+Token_kind Token_tape::kind(const std::size_t index) const noexcept
+{
+    return kinds_[index];
+}
+
+std::size_t Token_tape::offset(const std::size_t index) const noexcept
+{
+    return offsets_[index];
+}
+
+std::size_t Token_tape::length(const std::size_t index) const noexcept
+{
+    return lengths_[index];
+}
+
+std::string_view Token_tape::lexeme(const std::size_t index) const noexcept
+{
+    return source_.substr(offsets_[index], lengths_[index]);
+}
+
+Token_tape::Token_t Token_tape::token(const std::size_t index) const noexcept
+{
+    return {kinds_[index], lexeme(index)};
+}
+
+Symbol_id Token_tape::symbol(const std::size_t index) const noexcept
+{
+    return symbols_.empty() ? no_symbol : symbols_[index];
+}
+
+std::size_t Token_tape::line(const std::size_t index) const noexcept
+{
+    return lines_.line(offsets_[index]);
+}
+
+std::size_t Token_tape::column(const std::size_t index) const noexcept
+{
+    return lines_.column(offsets_[index]);
+}
+
+const Line_index& Token_tape::lines() const noexcept
+{
+    return lines_;
+}
+
+std::string_view Token_tape::source() const noexcept
+{
+    return source_;
+}
+
+std::size_t Token_tape::bytes() const noexcept
+{
+    return kinds_.capacity() * sizeof(Token_kind) + offsets_.capacity() * sizeof(uint32_t) +
+           lengths_.capacity() * sizeof(uint32_t) + symbols_.capacity() * sizeof(Symbol_id);
+}
+
+void Token_tape::detach()
+{
+    if (!storage_)
+    {
+        storage_ = std::make_shared<const std::string>(source_);
+
+        source_ = *storage_;
+    }
+}
+
+void Token_tape::push(const Token_kind kind, const std::size_t offset, const std::size_t length)
+{
+    kinds_.push_back(kind);
+
+    offsets_.push_back(static_cast<uint32_t>(offset));
+
+    lengths_.push_back(static_cast<uint32_t>(length));
+}
+
+void Token_tape::push(const Token_kind kind, const std::size_t offset, const std::size_t length, const Symbol_id symbol)
+{
+    push(kind, offset, length);
+
+    symbols_.push_back(symbol);
+}
+
+void Token_tape::finish(const std::string_view source)
+{
+    source_ = source;
+
+    lines_.build(source);
+
+    kinds_.shrink_to_fit();
+
+    offsets_.shrink_to_fit();
+
+    lengths_.shrink_to_fit();
+
+    symbols_.shrink_to_fit();
+}
+
+} // namespace parser::idl
@@ -0,0 +1,124 @@
+#include "parser/idl/utf8.hpp"
+
+#include <algorithm>
+#include <bit>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define PARSER_IDL_UTF8_X86 1
+#endif
+
+namespace parser::idl
+{
+namespace
+{
+/**
+ * Signed value above which a byte starts a code point: continuation bytes are 0x80-0xBF, i.e. -128 to -65.
+ */
+constexpr signed char continuation_max{-65};
+
+/**
+ * Signed value above which a non-ASCII byte starts a 4-byte sequence: leaders 0xF0 and up are -16 and up.
+ */
+constexpr signed char four_byte_leader_min{-17};
+
+std::size_t count_scalar(const char* data, const std::size_t size, const signed char threshold) noexcept
+{
+    return static_cast<std::size_t>(std::count_if(
+            data, data + size, [threshold](const char byte) { return static_cast<signed char>(byte) > threshold; }));
+}
+
+#ifdef PARSER_IDL_UTF8_X86
+
+__attribute__((target("sse2"))) std::size_t count_sse2(
+        const char* data, const std::size_t size, const signed char threshold) noexcept
+{
+    const auto limit{_mm_set1_epi8(threshold)};
+
+    std::size_t count{0};
+
+    std::size_t index{0};
+
+    for (; index + 16 <= size; index += 16)
+    {
+        const auto block{_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + index))};
+
+        count += static_cast<std::size_t>(
+                std::popcount(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpgt_epi8(block, limit)))));
+    }
+
+    return count + count_scalar(data + index, size - index, threshold);
+}
+
+__attribute__((target("avx2"))) std::size_t count_avx2(
+        const char* data, const std::size_t size, const signed char threshold) noexcept
+{
+    const auto limit{_mm256_set1_epi8(threshold)};
+
+    std::size_t count{0};
+
+    std::size_t index{0};
+
+    for (; index + 32 <= size; index += 32)
+    {
+        const auto block{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index))};
+
+        count += static_cast<std::size_t>(
+                std::popcount(static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(block, limit)))));
+    }
+
+    return count + count_sse2(data + index, size - index, threshold);
+}
+
+#endif
+
+} // namespace
+
+bool Utf8::ascii(const std::string_view text, const Isa isa) noexcept
+{
+    // Every ASCII byte is at or above zero as a signed value.
+    return count_above(text, -1, isa) == text.size();
+}
+
+std::size_t Utf8::code_points(const std::string_view text, const Isa isa) noexcept
+{
+    return count_above(text, continuation_max, isa);
+}
+
+std::size_t Utf8::utf16_units(const std::string_view text, const Isa isa) noexcept
+{
+    // Bytes above `four_byte_leader_min` are ASCII or start a 4-byte sequence; take the ASCII ones away.
+    const auto four_byte_leaders{count_above(text, four_byte_leader_min, isa) - count_above(text, -1, isa)};
+
+    return count_above(text, continuation_max, isa) + four_byte_leaders;
+}
+
+std::size_t Utf8::length(const std::string_view text, const Column_unit unit, const Isa isa) noexcept
+{
+    switch (unit)
+    {
+    case Column_unit::Code_points:
+        return code_points(text, isa);
+    case Column_unit::Utf16:
+        return utf16_units(text, isa);
+    default:
+        return text.size();
+    }
+}
+
+std::size_t Utf8::count_above(const std::string_view text, const signed char threshold, const Isa isa) noexcept
+{
+    switch (isa)
+    {
+#ifdef PARSER_IDL_UTF8_X86
+    case Isa::Avx2:
+        return count_avx2(text.data(), text.size(), threshold);
+    case Isa::Sse2:
+        return count_sse2(text.data(), text.size(), threshold);
+#endif
+    default:
+        return count_scalar(text.data(), text.size(), threshold);
+    }
+}
+
+} // namespace parser::idl
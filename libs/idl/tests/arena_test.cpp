@@ -0,0 +1,57 @@
+#include "parser/idl/arena.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+using namespace parser::idl;
+
+TEST(Arena_test, Allocations_are_aligned_and_distinct)
+{
+    Arena arena{64};
+
+    const auto* const a{arena.create<char>('a')};
+    const auto* const b{arena.create<double>(1.5)};
+    const auto* const c{arena.create<char>('c')};
+
+    EXPECT_EQ(*a, 'a');
+    EXPECT_EQ(*b, 1.5);
+    EXPECT_EQ(*c, 'c');
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(b) % alignof(double), 0);
+    EXPECT_EQ(arena.blocks(), 1);
+}
+
+TEST(Arena_test, Grows_by_blocks_and_resets)
+{
+    Arena arena{64};
+
+    for (int index{0}; index < 100; ++index)
+    {
+        (void) arena.create<int>(index);
+    }
+
+    EXPECT_GT(arena.blocks(), 1);
+    EXPECT_GE(arena.bytes(), 100 * sizeof(int));
+
+    arena.reset();
+
+    EXPECT_EQ(arena.blocks(), 1);
+    EXPECT_EQ(arena.bytes(), 0);
+}
+
+TEST(Arena_test, Copies_spans_contiguously)
+{
+    Arena arena{16};
+
+    const std::array<int, 32> values{1, 2, 3, 4, 5};
+
+    const auto copy{arena.copy(std::span<const int>{values})};
+
+    ASSERT_EQ(copy.size(), values.size());
+    EXPECT_TRUE(std::equal(copy.begin(), copy.end(), values.begin()));
+    EXPECT_NE(copy.data(), values.data());
+
+    EXPECT_TRUE(arena.copy(std::span<const int>{}).empty());
+}
@@ -0,0 +1,117 @@
+#include "parser/idl/comment_table.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "parser/idl/arena.hpp"
+#include "parser/idl/lexer_factory.hpp"
+#include "parser/idl/parser.hpp"
+#include "parser/idl/token_reader.hpp"
+#include "parser/idl/trivia_policy.hpp"
+
+using namespace parser::idl;
+
+static_assert(keep_comments.skip == layout_trivia);
+static_assert(skip_comments.skip.contains(Token_kind::Multi_line_comment));
+static_assert(!collect_comments.skip.contains(Token_kind::Identifier));
+static_assert(Trivia_policy{} == keep_comments);
+
+namespace
+{
+const std::string input{
+        "/** Point in the plane. */\n"
+        "// Second line of documentation.\n"
+        "struct Point { // members follow\n"
+        "  double x;\n"
+        "};\n"
+        "// trailing\n"};
+
+std::vector<Token_kind> kinds(Token_reader& reader)
+{
+    std::vector<Token_kind> kinds;
+
+    for (auto expected{reader.next()}; expected && *expected; expected = reader.next())
+    {
+        kinds.push_back(expected->value().kind());
+    }
+
+    return kinds;
+}
+
+} // namespace
+
+TEST(Comment_table_test, Collects_comments_by_following_token)
+{
+    Token_reader reader{Lexer_factory::build(), input};
+
+    reader.set_trivia(collect_comments);
+
+    const auto tokens{kinds(reader)};
+
+    ASSERT_EQ(tokens.size(), 8);
+    EXPECT_EQ(tokens.front(), Token_kind::Keyword_struct);
+
+    const auto& comments{reader.comments()};
+    ASSERT_EQ(comments.size(), 4);
+
+    const auto leading{comments.before(0)};
+    ASSERT_EQ(leading.size(), 2);
+    EXPECT_EQ(comments.text(leading[0]), "/** Point in the plane. */");
+    EXPECT_EQ(comments.text(leading[1]), "// Second line of documentation.");
+
+    const auto members{comments.before(3)};
+    ASSERT_EQ(members.size(), 1);
+    EXPECT_EQ(comments.text(members[0]), "// members follow");
+
+    EXPECT_TRUE(comments.before(1).empty());
+    ASSERT_EQ(comments.before(8).size(), 1);
+    EXPECT_EQ(comments.text(comments.before(8)[0]), "// trailing");
+
+    reader.reset();
+
+    EXPECT_TRUE(reader.comments().empty());
+    EXPECT_EQ(kinds(reader), tokens);
+    EXPECT_EQ(reader.comments().size(), 4);
+}
+
+TEST(Comment_table_test, Policies_filter_comments)
+{
+    Token_reader reader{Lexer_factory::build(), input};
+
+    const auto kept{kinds(reader)};
+    EXPECT_EQ(kept.size(), 12);
+    EXPECT_TRUE(reader.comments().empty());
+
+    reader.reset();
+
+    reader.set_trivia(skip_comments);
+
+    const auto skipped{kinds(reader)};
+    EXPECT_EQ(skipped.size(), 8);
+    EXPECT_TRUE(reader.comments().empty());
+
+    reader.reset();
+
+    ASSERT_TRUE(reader.peek(3).has_value());
+    EXPECT_EQ(reader.peek(3)->value().lexeme(), "double");
+    EXPECT_EQ(reader.location(3).line(), 4);
+}
+
+TEST(Comment_table_test, Parser_reads_through_collected_comments)
+{
+    Token_reader reader{Lexer_factory::build(), input};
+
+    reader.set_trivia(collect_comments);
+
+    Arena arena;
+
+    Parser parser{reader, arena};
+
+    const auto result{parser.parse()};
+
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result.value()->definitions.size(), 1);
+    EXPECT_EQ(reader.comments().size(), 4);
+}
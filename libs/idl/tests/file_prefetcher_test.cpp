@@ -0,0 +1,153 @@
+#include "parser/idl/file_prefetcher.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "parser/idl/lexer_factory.hpp"
+#include "parser/idl/token_reader.hpp"
+
+using namespace parser::idl;
+
+namespace
+{
+std::filesystem::path write(const std::string_view name, const std::string_view text)
+{
+    const auto path{std::filesystem::temp_directory_path() / name};
+
+    std::ofstream out{path, std::ios::binary};
+
+    out << text;
+
+    return path;
+}
+
+/**
+ * Waits until `count` reaches `expected` (or a generous timeout), then a little longer so an overshoot would show.
+ */
+std::size_t settle(const std::atomic<std::size_t>& count, const std::size_t expected)
+{
+    const auto deadline{std::chrono::steady_clock::now() + std::chrono::seconds{5}};
+
+    while (count.load() < expected && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+
+    return count.load();
+}
+
+} // namespace
+
+TEST(File_prefetcher_test, Loads_files_in_order)
+{
+    const std::vector<std::filesystem::path> files{
+            write("parser_prefetch_a.idl", "const long a = 1;\r\n"),
+            std::filesystem::temp_directory_path() / "parser_prefetch_missing.idl",
+            write("parser_prefetch_b.idl", "const long b = 2;\n")};
+
+    File_prefetcher prefetcher{files, 1};
+
+    Token_reader reader{Lexer_factory::build()};
+
+    auto first{prefetcher.next()};
+
+    ASSERT_TRUE(first.has_value());
+    ASSERT_TRUE(first->has_value());
+    EXPECT_EQ(**first, "const long a = 1;\n");
+
+    reader.load(std::move(**first));
+
+    const auto token{reader.next()};
+
+    ASSERT_TRUE(token && *token);
+    EXPECT_EQ(token->value().kind(), Token_kind::Keyword_const);
+
+    const auto missing{prefetcher.next()};
+
+    ASSERT_TRUE(missing.has_value());
+    ASSERT_FALSE(missing->has_value());
+    EXPECT_EQ(missing->error().file, files[1]);
+    EXPECT_FALSE(missing->error().message.empty());
+
+    const auto last{prefetcher.next()};
+
+    ASSERT_TRUE(last.has_value());
+    ASSERT_TRUE(last->has_value());
+    EXPECT_EQ(**last, "const long b = 2;\n");
+
+    EXPECT_FALSE(prefetcher.next().has_value());
+
+    std::filesystem::remove(files[0]);
+    std::filesystem::remove(files[2]);
+}
+
+TEST(File_prefetcher_test, Reads_ahead_at_most_depth_files)
+{
+    std::atomic<std::size_t> loaded{0};
+
+    const std::vector<std::filesystem::path> files(10, "virtual.idl");
+
+    {
+        File_prefetcher prefetcher{
+                files,
+                [&loaded](const std::filesystem::path&) -> File_prefetcher::Result_t {
+                    ++loaded;
+
+                    return "const long a = 1;\n";
+                },
+                3};
+
+        EXPECT_EQ(settle(loaded, 3), 3);
+
+        ASSERT_TRUE(prefetcher.next().has_value());
+
+        EXPECT_EQ(settle(loaded, 4), 4);
+    }
+
+    // Destroying the prefetcher with files left stops the I/O thread instead of loading them.
+    EXPECT_EQ(loaded.load(), 4);
+}
+
+TEST(File_prefetcher_test, Reports_a_throwing_source_as_a_diagnostic)
+{
+    const std::vector<std::filesystem::path> files{"good.idl", "bad.idl", "good.idl"};
+
+    File_prefetcher prefetcher{files, [](const std::filesystem::path& file) -> File_prefetcher::Result_t {
+                                   if (file == "bad.idl")
+                                   {
+                                       throw std::length_error{"file too large"};
+                                   }
+
+                                   return "const long a = 1;\n";
+                               }};
+
+    const auto good{prefetcher.next()};
+
+    ASSERT_TRUE(good.has_value());
+    EXPECT_TRUE(good->has_value());
+
+    const auto bad{prefetcher.next()};
+
+    ASSERT_TRUE(bad.has_value());
+    ASSERT_FALSE(bad->has_value());
+    EXPECT_EQ(bad->error().file, files[1]);
+    EXPECT_EQ(bad->error().message, "file too large");
+
+    const auto last{prefetcher.next()};
+
+    ASSERT_TRUE(last.has_value());
+    EXPECT_TRUE(last->has_value());
+
+    EXPECT_FALSE(prefetcher.next().has_value());
+}
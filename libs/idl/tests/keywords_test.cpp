@@ -0,0 +1,67 @@
+#include "parser/idl/keywords.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "parser/idl/lexer_factory.hpp"
+#include "parser/idl/token_reader.hpp"
+#include "parser/idl/tokens.hpp"
+
+using namespace parser::idl;
+
+static_assert(Keywords::classify("interface") == Token_kind::Keyword_interface);
+static_assert(Keywords::spelling(Token_kind::Keyword_void) == "void");
+static_assert(!Keywords::classify("Identifier").has_value());
+
+TEST(Keywords_test, Classifies_every_keyword)
+{
+    for (const auto& [spelling, kind] : Keywords::table)
+    {
+        EXPECT_EQ(Keywords::classify(spelling), kind);
+        EXPECT_EQ(Keywords::spelling(kind), spelling);
+        EXPECT_TRUE(Keywords::is_keyword(kind));
+    }
+}
+
+TEST(Keywords_test, Rejects_near_misses)
+{
+    for (const std::string identifier : {"", "i", "int", "inouts", "Module", "strings", "wchar_t", "x", "voi"})
+    {
+        EXPECT_FALSE(Keywords::classify(identifier).has_value()) << identifier;
+    }
+
+    EXPECT_FALSE(Keywords::is_keyword(Token_kind::Identifier));
+    EXPECT_TRUE(Keywords::spelling(Token_kind::Identifier).empty());
+}
+
+TEST(Keywords_test, Lexer_modes_produce_the_same_tokens)
+{
+    const std::string input{
+            "module m { interface i { attribute long a; void f(in string s, out octet o) raises (e); }; };\n"
+            "struct s_1 { unsigned short x; sequence y; wchar z; }; // inout\n"};
+
+    Token_reader rules{Lexer_factory::build(Keyword_mode::Rules), input};
+
+    Token_reader hashed{Lexer_factory::build(Keyword_mode::Perfect_hash), input};
+
+    for (;;)
+    {
+        const auto expected_rules{rules.next()};
+        const auto expected_hashed{hashed.next()};
+        ASSERT_TRUE(expected_rules.has_value());
+        ASSERT_TRUE(expected_hashed.has_value());
+
+        const auto& optional_rules{expected_rules.value()};
+        const auto& optional_hashed{expected_hashed.value()};
+        ASSERT_EQ(optional_rules.has_value(), optional_hashed.has_value());
+
+        if (!optional_rules)
+        {
+            break; // EOF
+        }
+
+        EXPECT_EQ(optional_rules->kind(), optional_hashed->kind());
+        EXPECT_EQ(optional_rules->lexeme(), optional_hashed->lexeme());
+    }
+}
@@ -0,0 +1,135 @@
+#include "parser/idl/newline_normalizer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace parser::idl;
+
+namespace
+{
+std::vector<Isa> supported_isas()
+{
+    std::vector<Isa> isas;
+
+    for (const auto isa : {Isa::Scalar, Isa::Sse2, Isa::Avx2})
+    {
+        if (isa_supported(isa))
+        {
+            isas.push_back(isa);
+        }
+    }
+
+    return isas;
+}
+
+std::string reference_normalize(const std::string& input)
+{
+    std::string output;
+
+    for (std::size_t index = 0; index < input.size(); ++index)
+    {
+        if (input[index] == '\r')
+        {
+            if (index + 1 < input.size() && input[index + 1] == '\n')
+            {
+                ++index;
+            }
+
+            output.push_back('\n');
+        }
+        else
+        {
+            output.push_back(input[index]);
+        }
+    }
+
+    return output;
+}
+
+} // namespace
+
+TEST(Newline_normalizer_test, Input_without_carriage_return_is_untouched)
+{
+    const std::string input(1000, 'x');
+
+    for (const auto isa : supported_isas())
+    {
+        EXPECT_EQ(Newline_normalizer::find_carriage_return(input, isa), std::string::npos);
+        EXPECT_EQ(Newline_normalizer::normalize(std::string_view{input}, isa), input);
+
+        std::string buffer{input};
+
+        const auto* data{buffer.data()};
+
+        Newline_normalizer::normalize(buffer, isa);
+
+        EXPECT_EQ(buffer, input);
+        EXPECT_EQ(buffer.data(), data);
+    }
+}
+
+TEST(Newline_normalizer_test, Line_endings_across_block_boundaries)
+{
+    // Place CR, CRLF and CRCR at every offset around the 16- and 32-byte block boundaries.
+    for (const std::string ending : {"\r", "\r\n", "\r\r", "\n\r"})
+    {
+        for (std::size_t offset = 0; offset < 70; ++offset)
+        {
+            std::string input(offset, 'a');
+
+            input += ending;
+
+            input += std::string(70, 'b');
+
+            const auto expected{reference_normalize(input)};
+
+            for (const auto isa : supported_isas())
+            {
+                EXPECT_EQ(Newline_normalizer::find_carriage_return(input, isa), input.find('\r'));
+                EXPECT_EQ(Newline_normalizer::normalize(std::string_view{input}, isa), expected);
+
+                std::string buffer{input};
+
+                Newline_normalizer::normalize(buffer, isa);
+
+                EXPECT_EQ(buffer, expected);
+            }
+        }
+    }
+}
+
+TEST(Newline_normalizer_test, Matches_reference_on_random_input)
+{
+    std::mt19937 engine{42};
+
+    std::uniform_int_distribution<int> pick{0, 5};
+
+    for (int round = 0; round < 50; ++round)
+    {
+        std::string input;
+
+        for (std::size_t index = 0; index < 1000; ++index)
+        {
+            const auto choice{pick(engine)};
+
+            input.push_back(choice == 0 ? '\r' : choice == 1 ? '\n' : static_cast<char>('a' + choice));
+        }
+
+        const auto expected{reference_normalize(input)};
+
+        for (const auto isa : supported_isas())
+        {
+            EXPECT_EQ(Newline_normalizer::normalize(std::string_view{input}, isa), expected);
+
+            std::string buffer{input};
+
+            Newline_normalizer::normalize(buffer, isa);
+
+            EXPECT_EQ(buffer, expected);
+        }
+    }
+}
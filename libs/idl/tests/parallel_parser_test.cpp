@@ -0,0 +1,145 @@
+#include "parser/idl/parallel_parser.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "parser/idl/arena.hpp"
+#include "parser/idl/ast.hpp"
+#include "parser/idl/lexer_factory.hpp"
+#include "parser/idl/parser.hpp"
+#include "parser/idl/token_reader.hpp"
+
+using namespace parser::idl;
+
+namespace
+{
+std::string make_modules(const std::size_t modules)
+{
+    std::string text{"// generated\n"};
+
+    for (std::size_t index{0}; index < modules; ++index)
+    {
+        const auto name{std::to_string(index)};
+
+        text += "module m" + name + " {\n";
+        text += "  const string s" + name + " = \"}; {\";\n";
+        text += "  interface i" + name + " { void f(in long a); }; // };\n";
+        text += "};\n";
+    }
+
+    return text;
+}
+
+std::shared_ptr<const lexer::core::Lexer> shared_lexer()
+{
+    return std::make_shared<const lexer::core::Lexer>(Lexer_factory::build());
+}
+
+} // namespace
+
+TEST(Parallel_parser_test, Split_skips_literals_and_comments)
+{
+    const std::string_view text{
+            "const string a = \"x; {\";\n"
+            "/* ;\n */ struct s { long x; };\n"
+            "module m { const long b = 1; };\n"
+            "const long c = 2; // {\n"
+            "const long d = 3;\n"};
+
+    const auto regions{Parallel_parser::split(text, 8, 1)};
+
+    ASSERT_TRUE(regions.has_value());
+    ASSERT_EQ(regions->size(), 5);
+
+    EXPECT_EQ((*regions)[0].offset, 0);
+    EXPECT_EQ(text.substr((*regions)[1].offset, 7), "/* ;\n *");
+    EXPECT_EQ(text.substr((*regions)[2].offset, 8), "module m");
+    EXPECT_EQ(text.substr((*regions)[3].offset, 12), "const long c");
+    EXPECT_EQ(text.substr((*regions)[4].offset, 12), "const long d");
+    EXPECT_EQ((*regions)[4].offset + (*regions)[4].length, text.size());
+}
+
+TEST(Parallel_parser_test, Split_rejects_ambiguous_input)
+{
+    EXPECT_FALSE(Parallel_parser::split("module m { const long a = 1;\n", 4, 1).has_value());
+    EXPECT_FALSE(Parallel_parser::split("};\nconst long a = 1;\n", 4, 1).has_value());
+    EXPECT_FALSE(Parallel_parser::split("#include \"a.idl\"\nconst long a = 1;\n", 4, 1).has_value());
+    EXPECT_FALSE(Parallel_parser::split("const string a = \"open;\nconst long b = 1;\n", 4, 1).has_value());
+    EXPECT_FALSE(Parallel_parser::split("/* open;\nconst long b = 1;\n", 4, 1).has_value());
+}
+
+TEST(Parallel_parser_test, Matches_sequential_parse)
+{
+    const auto text{make_modules(200)};
+
+    Token_reader reader{Lexer_factory::build(), text};
+
+    Arena arena;
+
+    Parser sequential{reader, arena};
+
+    const auto expected{sequential.parse()};
+
+    ASSERT_TRUE(expected.has_value()) << expected.error().message;
+
+    Parallel_parser parser{shared_lexer(), 4, 256};
+
+    const auto result{parser.parse(text)};
+
+    ASSERT_TRUE(result.has_value()) << result.error().message;
+    ASSERT_GT(parser.regions().size(), 1);
+    ASSERT_EQ((*result)->definitions.size(), (*expected)->definitions.size());
+
+    for (std::size_t index{0}; index < (*result)->definitions.size(); ++index)
+    {
+        const auto* const module{(*result)->definitions[index]->as<ast::Module>()};
+
+        ASSERT_NE(module, nullptr);
+        ASSERT_EQ(module->name, (*expected)->definitions[index]->name);
+        ASSERT_EQ(module->definitions.size(), 2);
+
+        const auto offset{parser.offset(module->name)};
+
+        ASSERT_EQ(parser.text().substr(offset, module->name.size()), module->name);
+        ASSERT_EQ(parser.line(offset), 2 + 4 * index);
+        ASSERT_EQ(parser.column(offset), 8);
+
+        const auto* const constant{module->definitions[0]->as<ast::Const>()};
+
+        ASSERT_NE(constant, nullptr);
+        ASSERT_EQ(constant->value->text, "\"}; {\"");
+    }
+}
+
+TEST(Parallel_parser_test, Errors_match_sequential_parse)
+{
+    auto text{make_modules(100)};
+
+    text += "module broken { const long x = ; };\n";
+
+    text += make_modules(100);
+
+    Token_reader reader{Lexer_factory::build(), text};
+
+    Arena arena;
+
+    Parser sequential{reader, arena};
+
+    const auto expected{sequential.parse()};
+
+    ASSERT_FALSE(expected.has_value());
+
+    Parallel_parser parser{shared_lexer(), 4, 256};
+
+    const auto result{parser.parse(text)};
+
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error().offset, expected.error().offset);
+    EXPECT_EQ(result.error().line, expected.error().line);
+    EXPECT_EQ(result.error().column, expected.error().column);
+    EXPECT_EQ(result.error().message, expected.error().message);
+}
@@ -0,0 +1,239 @@
+#include "parser/idl/parser.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "parser/idl/arena.hpp"
+#include "parser/idl/ast.hpp"
+#include "parser/idl/lexer_factory.hpp"
+#include "parser/idl/token_reader.hpp"
+#include "parser/idl/trivia_policy.hpp"
+
+using namespace parser::idl;
+
+namespace
+{
+class Parser_test : public testing::Test
+{
+public:
+    const ast::Specification& parse(const std::string& input)
+    {
+        reader_.load(input);
+
+        Parser parser{reader_, arena_};
+
+        const auto result{parser.parse()};
+
+        if (!result)
+        {
+            ADD_FAILURE() << result.error().line << ":" << result.error().column << ": " << result.error().message;
+
+            static const ast::Specification empty{};
+
+            return empty;
+        }
+
+        return *result.value();
+    }
+
+    Parser::Result_t try_parse(const std::string& input)
+    {
+        reader_.load(input);
+
+        Parser parser{reader_, arena_};
+
+        return parser.parse();
+    }
+
+private:
+    Token_reader reader_{Lexer_factory::build()};
+
+    Arena arena_;
+};
+
+} // namespace
+
+TEST_F(Parser_test, Module_with_nested_definitions)
+{
+    const auto& specification{parse(
+            "// generated\n"
+            "module outer {\n"
+            "  module inner { const long size = 2 * (3 + 4); };\n"
+            "  typedef sequence<long, 10> Longs, Matrix[3][4];\n"
+            "  enum Color { red, green, blue };\n"
+            "  struct Point { double x, y; string<16> label; };\n"
+            "  exception Failed { wstring reason; };\n"
+            "};\n")};
+
+    ASSERT_EQ(specification.definitions.size(), 1);
+
+    const auto* const outer{specification.definitions[0]->as<ast::Module>()};
+    ASSERT_NE(outer, nullptr);
+    EXPECT_EQ(outer->name, "outer");
+    ASSERT_EQ(outer->definitions.size(), 5);
+
+    const auto* const inner{outer->definitions[0]->as<ast::Module>()};
+    ASSERT_NE(inner, nullptr);
+    const auto* const size{inner->definitions[0]->as<ast::Const>()};
+    ASSERT_NE(size, nullptr);
+    EXPECT_EQ(size->name, "size");
+    EXPECT_EQ(size->type->primitive, ast::Primitive::Long);
+    EXPECT_EQ(size->value->kind, ast::Expression_kind::Binary);
+    EXPECT_EQ(size->value->op, Token_kind::Operator_asterisk);
+    EXPECT_EQ(size->value->left->text, "2");
+    EXPECT_EQ(size->value->right->op, Token_kind::Operator_plus);
+
+    const auto* const longs{outer->definitions[1]->as<ast::Typedef>()};
+    ASSERT_NE(longs, nullptr);
+    EXPECT_EQ(longs->type->kind, ast::Type_kind::Sequence);
+    EXPECT_EQ(longs->type->element->primitive, ast::Primitive::Long);
+    EXPECT_EQ(longs->type->bound->text, "10");
+    ASSERT_EQ(longs->declarators.size(), 2);
+    EXPECT_EQ(longs->declarators[1].name, "Matrix");
+    EXPECT_EQ(longs->declarators[1].dimensions.size(), 2);
+
+    const auto* const color{outer->definitions[2]->as<ast::Enum>()};
+    ASSERT_NE(color, nullptr);
+    ASSERT_EQ(color->enumerators.size(), 3);
+    EXPECT_EQ(color->enumerators[2], "blue");
+
+    const auto* const point{outer->definitions[3]->as<ast::Struct>()};
+    ASSERT_NE(point, nullptr);
+    ASSERT_EQ(point->members.size(), 2);
+    EXPECT_EQ(point->members[0].declarators.size(), 2);
+    EXPECT_EQ(point->members[1].type->kind, ast::Type_kind::String);
+    EXPECT_EQ(point->members[1].type->bound->text, "16");
+
+    const auto* const failed{outer->definitions[4]->as<ast::Exception>()};
+    ASSERT_NE(failed, nullptr);
+    EXPECT_EQ(failed->members[0].type->kind, ast::Type_kind::Wide_string);
+}
+
+TEST_F(Parser_test, Interface_with_attributes_and_operations)
+{
+    const auto& specification{parse(
+            "interface Account : Base, ::bank::Audited {\n"
+            "  attribute unsigned long long balance, limit;\n"
+            "  void deposit(in long amount, out boolean ok) raises (bank::Frozen, Failed);\n"
+            "  operation long double rate();\n"
+            "  const short max = -1;\n"
+            "};\n")};
+
+    ASSERT_EQ(specification.definitions.size(), 1);
+
+    const auto* const account{specification.definitions[0]->as<ast::Interface>()};
+    ASSERT_NE(account, nullptr);
+    ASSERT_EQ(account->bases.size(), 2);
+    ASSERT_EQ(account->bases[1].parts.size(), 3);
+    EXPECT_TRUE(account->bases[1].parts[0].empty());
+    EXPECT_EQ(account->bases[1].parts[2], "Audited");
+    ASSERT_EQ(account->exports.size(), 4);
+
+    const auto* const balance{account->exports[0]->as<ast::Attribute>()};
+    ASSERT_NE(balance, nullptr);
+    EXPECT_EQ(balance->type->primitive, ast::Primitive::Unsigned_long_long);
+    EXPECT_EQ(balance->names.size(), 2);
+
+    const auto* const deposit{account->exports[1]->as<ast::Operation>()};
+    ASSERT_NE(deposit, nullptr);
+    EXPECT_EQ(deposit->result->primitive, ast::Primitive::Void);
+    ASSERT_EQ(deposit->parameters.size(), 2);
+    EXPECT_EQ(deposit->parameters[1].direction, ast::Direction::Out);
+    EXPECT_EQ(deposit->parameters[1].name, "ok");
+    ASSERT_EQ(deposit->raises.size(), 2);
+    EXPECT_EQ(deposit->raises[0].parts[1], "Frozen");
+
+    const auto* const rate{account->exports[2]->as<ast::Operation>()};
+    ASSERT_NE(rate, nullptr);
+    EXPECT_EQ(rate->result->primitive, ast::Primitive::Long_double);
+    EXPECT_TRUE(rate->parameters.empty());
+
+    EXPECT_NE(account->exports[3]->as<ast::Const>(), nullptr);
+}
+
+TEST_F(Parser_test, Union_with_case_labels)
+{
+    const auto& specification{parse(
+            "union Value switch (Kind) {\n"
+            "  case small: case Kind::tiny: short s;\n"
+            "  case 3: string text;\n"
+            "  default: octet raw[8];\n"
+            "};\n")};
+
+    const auto* const value{specification.definitions[0]->as<ast::Union>()};
+    ASSERT_NE(value, nullptr);
+    EXPECT_EQ(value->discriminator->kind, ast::Type_kind::Named);
+    ASSERT_EQ(value->cases.size(), 3);
+    ASSERT_EQ(value->cases[0].labels.size(), 2);
+    EXPECT_EQ(value->cases[0].labels[1]->name.parts[1], "tiny");
+    EXPECT_EQ(value->cases[1].declarator.name, "text");
+    EXPECT_TRUE(value->cases[2].is_default);
+    EXPECT_EQ(value->cases[2].declarator.dimensions.size(), 1);
+}
+
+TEST_F(Parser_test, Syntax_error_reports_position)
+{
+    const auto result{try_parse("module m {\n  struct s { long };\n};\n")};
+
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error().line, 2);
+    EXPECT_EQ(result.error().column, 19);
+    EXPECT_EQ(result.error().offset, 29);
+    EXPECT_EQ(result.error().message, "expected an identifier, found '}'");
+}
+
+TEST_F(Parser_test, Syntax_error_column_counts_in_the_reader_unit)
+{
+    for (const auto unit : {Column_unit::Bytes, Column_unit::Code_points, Column_unit::Utf16})
+    {
+        Token_reader reader{Lexer_factory::build()};
+
+        reader.set_column_unit(unit);
+
+        reader.load(std::string{"struct \"\xC3\xA9\xC3\xA9\xC3\xA9\" {};\n"});
+
+        Arena arena;
+
+        Parser parser{reader, arena};
+
+        const auto result{parser.parse()};
+
+        ASSERT_FALSE(result.has_value());
+        EXPECT_EQ(result.error().line, 1);
+        EXPECT_EQ(result.error().column, 8) << static_cast<int>(unit);
+        EXPECT_EQ(result.error().offset, 7);
+    }
+}
+
+TEST_F(Parser_test, Reader_skips_comments_while_parsing)
+{
+    const std::string input{"// a\nmodule m { /* b */ struct s { long x; // c\n }; };\n"};
+
+    for (const auto& policy : {keep_comments, collect_comments})
+    {
+        Token_reader reader{Lexer_factory::build(), input};
+
+        reader.set_trivia(policy);
+
+        Arena arena;
+
+        Parser parser{reader, arena};
+
+        const auto result{parser.parse()};
+
+        ASSERT_TRUE(result.has_value()) << result.error().message;
+        ASSERT_EQ(result.value()->definitions.size(), 1);
+
+        EXPECT_EQ(reader.trivia(), policy);
+        EXPECT_EQ(reader.comments().size(), policy.record_comments ? 3 : 0);
+    }
+}
+
+TEST_F(Parser_test, Unexpected_end_of_input)
+{
+    const auto result{try_parse("interface i {")};
+
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error().message, "expected a type, found end of input");
+}
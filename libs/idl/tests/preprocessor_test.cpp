@@ -0,0 +1,241 @@
+#include "parser/idl/preprocessor.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "parser/idl/arena.hpp"
+#include "parser/idl/ast.hpp"
+#include "parser/idl/lexer_factory.hpp"
+#include "parser/idl/source_cache.hpp"
+#include "parser/idl/source_manager.hpp"
+#include "parser/idl/token_reader.hpp"
+#include "parser/idl/tokens.hpp"
+
+using namespace parser::idl;
+
+namespace
+{
+class Preprocessor_test : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        root_ = std::filesystem::temp_directory_path() / "parser_preprocessor_test";
+
+        std::filesystem::remove_all(root_);
+
+        std::filesystem::create_directories(root_ / "include");
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(root_);
+    }
+
+    std::filesystem::path write(const std::filesystem::path& name, const std::string_view text) const
+    {
+        const auto path{root_ / name};
+
+        std::ofstream out{path, std::ios::binary};
+
+        out << text;
+
+        return path;
+    }
+
+    std::filesystem::path root_;
+
+    Source_cache cache_{std::make_shared<const lexer::core::Lexer>(Lexer_factory::build())};
+};
+
+} // namespace
+
+TEST_F(Preprocessor_test, Expands_includes_once_and_keeps_locations)
+{
+    write("once.idl", "#pragma once\nconst long a = 1;\n");
+
+    write("include/guarded.idl", "#ifndef GUARDED\n#define GUARDED\nconst long b = 2;\n#endif\n");
+
+    const auto main{write(
+            "main.idl",
+            "#include \"once.idl\"\n#include <guarded.idl>\n#include \"once.idl\"\n#include <guarded.idl>\n"
+            "const long c = 3;\n")};
+
+    Preprocessor preprocessor{{root_ / "include"}, cache_};
+
+    const auto unit{preprocessor.run(main)};
+
+    ASSERT_TRUE(unit.has_value()) << unit.error().message;
+    ASSERT_EQ(unit->size(), 18);
+    ASSERT_EQ(unit->segments().size(), 3);
+
+    EXPECT_EQ(unit->lexeme(2), "a");
+    EXPECT_EQ(unit->file(2), std::filesystem::canonical(root_ / "once.idl"));
+    EXPECT_EQ(unit->line(2), 2);
+    EXPECT_EQ(unit->column(2), 12);
+
+    EXPECT_EQ(unit->lexeme(8), "b");
+    EXPECT_EQ(unit->file(8), std::filesystem::canonical(root_ / "include/guarded.idl"));
+    EXPECT_EQ(unit->line(8), 3);
+
+    EXPECT_EQ(unit->kind(14), Token_kind::Identifier);
+    EXPECT_EQ(unit->lexeme(14), "c");
+    EXPECT_EQ(unit->file(14), std::filesystem::canonical(main));
+    EXPECT_EQ(unit->line(14), 5);
+    EXPECT_EQ(unit->column(14), 12);
+}
+
+TEST_F(Preprocessor_test, Compact_locations_decode_to_file_line_and_column)
+{
+    write("plain.idl", "const long p = 1;\n");
+
+    const auto main{write("main.idl", "#include \"plain.idl\"\n#include \"plain.idl\"\n  const long c = 3;\n")};
+
+    Preprocessor preprocessor{{}, cache_};
+
+    const auto unit{preprocessor.run(main)};
+
+    ASSERT_TRUE(unit.has_value()) << unit.error().message;
+
+    Source_manager manager;
+
+    const auto locations{unit->locations(manager)};
+
+    ASSERT_EQ(locations.size(), unit->size());
+    EXPECT_EQ(manager.files(), 2); // plain.idl is registered once for both inclusions
+    EXPECT_EQ(locations[0], locations[6]);
+
+    for (std::size_t index{0}; index < unit->size(); ++index)
+    {
+        const auto decoded{manager.decode(locations[index])};
+
+        ASSERT_EQ(manager.name(decoded.file), unit->file(index));
+        ASSERT_EQ(decoded.line, unit->line(index));
+        ASSERT_EQ(decoded.column, unit->column(index));
+    }
+}
+
+TEST_F(Preprocessor_test, Cache_reuses_unchanged_files)
+{
+    const auto path{write("types.idl", "typedef long counter;\n")};
+
+    const auto first{cache_.load(path)};
+    const auto second{cache_.load(root_ / "." / "types.idl")};
+
+    ASSERT_TRUE(first.has_value());
+    ASSERT_TRUE(second.has_value());
+    EXPECT_EQ(*first, *second);
+    EXPECT_EQ(cache_.size(), 1);
+
+    write("types.idl", "typedef short counter;\n");
+
+    std::filesystem::last_write_time(path, (*first)->modified + std::chrono::seconds{1});
+
+    const auto reloaded{cache_.load(path)};
+
+    ASSERT_TRUE(reloaded.has_value());
+    EXPECT_NE(*reloaded, *first);
+    EXPECT_EQ((*reloaded)->tape.lexeme(1), "short");
+    EXPECT_EQ((*first)->tape.lexeme(1), "long");
+}
+
+TEST_F(Preprocessor_test, Missing_include_names_the_includer)
+{
+    const auto main{write("main.idl", "const long a = 1;\n#include \"absent.idl\"\n")};
+
+    Preprocessor preprocessor{{}, cache_};
+
+    const auto unit{preprocessor.run(main)};
+
+    ASSERT_FALSE(unit.has_value());
+    EXPECT_EQ(unit.error().file, std::filesystem::canonical(main));
+    EXPECT_EQ(unit.error().line, 2);
+    EXPECT_NE(unit.error().message.find("absent.idl"), std::string::npos);
+}
+
+TEST_F(Preprocessor_test, Reports_cycles_and_unsupported_directives)
+{
+    write("a.idl", "#include \"b.idl\"\nconst long a = 1;\n");
+
+    const auto b{write("b.idl", "#include \"a.idl\"\n")};
+
+    Preprocessor preprocessor{{}, cache_};
+
+    const auto cycle{preprocessor.run(b)};
+
+    ASSERT_FALSE(cycle.has_value());
+    EXPECT_NE(cycle.error().message.find("nested too deeply"), std::string::npos);
+
+    const auto macro{write("macro.idl", "#define SIZE 4\nconst long a = 1;\n")};
+
+    const auto unsupported{preprocessor.run(macro)};
+
+    ASSERT_FALSE(unsupported.has_value());
+    EXPECT_EQ(unsupported.error().line, 1);
+    EXPECT_NE(unsupported.error().message.find("#define"), std::string::npos);
+}
+
+TEST_F(Preprocessor_test, Hash_in_comments_and_literals_is_not_a_directive)
+{
+    const auto main{write(
+            "main.idl",
+            "/*\n#1 note in a doc comment\n*/\n"
+            "const string s = \"# not a directive\"; // # nor this\n"
+            "module m { const long x = 1; };\n")};
+
+    Preprocessor preprocessor{{}, cache_};
+
+    const auto unit{preprocessor.run(main)};
+
+    ASSERT_TRUE(unit.has_value()) << unit.error().message;
+    ASSERT_EQ(unit->size(), 19);
+    EXPECT_EQ(unit->kind(0), Token_kind::Multi_line_comment);
+    EXPECT_EQ(unit->lexeme(0), "/*\n#1 note in a doc comment\n*/");
+    EXPECT_EQ(unit->lexeme(5), "\"# not a directive\"");
+    EXPECT_EQ(unit->line(8), 5); // 'module'
+}
+
+TEST_F(Preprocessor_test, Parses_included_declarations)
+{
+    write("types.idl", "struct point { long x; long y; };\n");
+
+    write("broken.idl", "\nconst long = 1;\n");
+
+    const auto main{write("main.idl", "#include \"types.idl\"\nmodule m { typedef point p; };\n")};
+
+    Preprocessor preprocessor{{}, cache_};
+
+    const auto unit{preprocessor.run(main)};
+
+    ASSERT_TRUE(unit.has_value()) << unit.error().message;
+
+    Token_reader reader{Lexer_factory::build()};
+
+    Arena arena;
+
+    const auto specification{unit->parse(reader, arena)};
+
+    ASSERT_TRUE(specification.has_value()) << specification.error().message;
+    ASSERT_EQ((*specification)->definitions.size(), 2);
+    EXPECT_EQ((*specification)->definitions[0]->name, "point");
+    EXPECT_EQ((*specification)->definitions[1]->name, "m");
+
+    const auto failing{write("failing.idl", "module ok { };\n#include \"broken.idl\"\n")};
+
+    const auto broken_unit{preprocessor.run(failing)};
+
+    ASSERT_TRUE(broken_unit.has_value()) << broken_unit.error().message;
+
+    const auto error{broken_unit->parse(reader, arena)};
+
+    ASSERT_FALSE(error.has_value());
+    EXPECT_EQ(error.error().file, std::filesystem::canonical(root_ / "broken.idl"));
+    EXPECT_EQ(error.error().line, 2);
+    EXPECT_EQ(error.error().column, 12);
+}
@@ -0,0 +1,98 @@
+#include "parser/idl/reader_metrics.hpp"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "parser/idl/lexer_factory.hpp"
+#include "parser/idl/token_batch.hpp"
+#include "parser/idl/token_reader.hpp"
+
+using namespace parser::idl;
+
+static_assert(sizeof(Metrics_recorder<false>) == 1);
+
+TEST(Reader_metrics_test, Reader_counts_hot_path_events)
+{
+    Token_reader reader{Lexer_factory::build(), std::string{"module m {\r\n  const long x = 1;\r\n};\r\n"}};
+
+    ASSERT_TRUE(reader.peek(1).has_value());
+    ASSERT_TRUE(reader.peek(0).has_value());
+
+    for (auto expected{reader.next()}; expected && *expected; expected = reader.next())
+    {
+    }
+
+    const auto metrics{reader.metrics()};
+
+    if constexpr (!Reader_metrics::enabled)
+    {
+        EXPECT_EQ(metrics.total(), 0);
+        EXPECT_EQ(metrics.tokenizer_calls, 0);
+
+        return;
+    }
+
+    EXPECT_EQ(metrics.bytes_normalized, 37);
+    EXPECT_EQ(metrics.carriage_returns, 3);
+    EXPECT_EQ(metrics.count(Token_kind::Keyword_module), 1);
+    EXPECT_EQ(metrics.count(Token_kind::Identifier), 2);
+    EXPECT_EQ(metrics.total() - metrics.skipped, 11);
+    EXPECT_EQ(metrics.skipped, metrics.count(Token_kind::Whitespace) + metrics.count(Token_kind::Newline));
+    EXPECT_EQ(metrics.tokenizer_calls, metrics.total() + 1);
+    EXPECT_GT(metrics.peek_hits, 0);
+    EXPECT_EQ(metrics.lexical_errors, 0);
+    EXPECT_GT(metrics.tokenizer_cycles, 0);
+
+    reader.reset_metrics();
+
+    EXPECT_EQ(reader.metrics().total(), 0);
+}
+
+TEST(Reader_metrics_test, Batch_reports_per_file_and_total)
+{
+    const auto directory{std::filesystem::temp_directory_path()};
+
+    const std::vector<std::filesystem::path> files{
+            directory / "reader_metrics_first.idl", directory / "reader_metrics_second.idl"};
+    {
+        std::ofstream first{files[0]};
+        std::ofstream second{files[1]};
+
+        first << "struct a { long b; };";
+        second << "const long c = 1;\n$";
+    }
+
+    Token_batch batch{Lexer_factory::build(), 2};
+
+    const auto results{batch.tokenize(files)};
+
+    const auto first{batch.metrics(0)};
+    const auto second{batch.metrics(1)};
+    const auto total{batch.metrics()};
+
+    for (const auto& file : files)
+    {
+        std::filesystem::remove(file);
+    }
+
+    ASSERT_TRUE(results[0].has_value());
+    ASSERT_FALSE(results[1].has_value());
+
+    if constexpr (!Reader_metrics::enabled)
+    {
+        EXPECT_EQ(total.total(), 0);
+
+        return;
+    }
+
+    EXPECT_EQ(first.count(Token_kind::Keyword_struct), 1);
+    EXPECT_EQ(first.lexical_errors, 0);
+    EXPECT_EQ(second.lexical_errors, 1);
+    EXPECT_EQ(total.total(), first.total() + second.total());
+    EXPECT_EQ(total.lexical_errors, 1);
+    EXPECT_EQ(total.bytes_normalized, first.bytes_normalized + second.bytes_normalized);
+}
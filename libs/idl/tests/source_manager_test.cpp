@@ -0,0 +1,56 @@
+#include "parser/idl/source_manager.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+using namespace parser::idl;
+
+TEST(Source_manager_test, Decodes_locations_across_files)
+{
+    Source_manager manager;
+
+    const std::string first{"module m {\n  const long a = 1;\n};\n"};
+
+    const std::string second{"struct s {\n};"};
+
+    const auto a{manager.add("a.idl", first)};
+
+    const auto b{manager.add("b.idl", second)};
+
+    EXPECT_EQ(manager.files(), 2);
+    EXPECT_NE(a, b);
+
+    const auto constant{manager.location(a, first.find("const"))};
+
+    const auto brace{manager.location(b, second.find('}'))};
+
+    const auto end_of_a{manager.location(a, first.size())};
+
+    EXPECT_EQ(manager.file(constant), a);
+    EXPECT_EQ(manager.file(end_of_a), a); // The end of a buffer is not the start of the next one
+    EXPECT_EQ(manager.file(brace), b);
+    EXPECT_LT(end_of_a, manager.location(b, 0));
+
+    const auto decoded{manager.decode(constant)};
+
+    EXPECT_EQ(decoded.file, a);
+    EXPECT_EQ(decoded.offset, 13);
+    EXPECT_EQ(decoded.line, 2);
+    EXPECT_EQ(decoded.column, 3);
+
+    EXPECT_EQ(manager.decode(Source_location::from_raw(brace.raw())).line, 2);
+    EXPECT_EQ(manager.decode(constant.advanced(6)).column, 9);
+
+    const auto diagnostic{manager.diagnostic(brace, "unexpected '}'")};
+
+    EXPECT_EQ(diagnostic.file, "b.idl");
+    EXPECT_EQ(diagnostic.line, 2);
+    EXPECT_EQ(diagnostic.column, 1);
+    EXPECT_EQ(diagnostic.message, "unexpected '}'");
+
+    EXPECT_FALSE(Source_location{}.valid());
+    EXPECT_EQ(manager.file(Source_location{}), no_file);
+    EXPECT_EQ(manager.decode(Source_location::from_raw(1'000'000)).file, no_file);
+    EXPECT_EQ(manager.diagnostic(Source_location{}, "lost").line, 0);
+}
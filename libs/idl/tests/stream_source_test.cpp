@@ -0,0 +1,160 @@
+#include "parser/idl/stream_source.hpp"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+#include "parser/idl/lexer_factory.hpp"
+#include "parser/idl/token_reader.hpp"
+
+using namespace parser::idl;
+
+namespace
+{
+/**
+ * Kinds and lexemes of every token `reader` returns, up to the end of its input or a lexical error.
+ */
+std::vector<std::pair<Token_kind, std::string>> read_all(Token_reader& reader)
+{
+    std::vector<std::pair<Token_kind, std::string>> tokens;
+
+    for (auto expected{reader.next()}; expected && *expected; expected = reader.next())
+    {
+        tokens.emplace_back(expected->value().kind(), std::string{expected->value().lexeme()});
+    }
+
+    return tokens;
+}
+
+} // namespace
+
+TEST(Stream_source_test, Windows_end_after_whole_lines)
+{
+    std::istringstream stream{"ab\r\ncd\ref\r"};
+
+    Stream_source source{stream, 3};
+
+    EXPECT_EQ(source.window(0), "ab\n");
+    EXPECT_FALSE(source.exhausted());
+
+    EXPECT_EQ(source.window(3), "cd\n");
+
+    EXPECT_EQ(source.window(3), "ef\n");
+    EXPECT_TRUE(source.exhausted());
+
+    EXPECT_EQ(source.window(3), std::nullopt);
+}
+
+TEST(Stream_source_test, Unconsumed_text_starts_the_next_window)
+{
+    std::istringstream stream{"x /* a\nb */\ny\n"};
+
+    Stream_source source{stream, 4};
+
+    EXPECT_EQ(source.window(0), "x /* a\n");
+    EXPECT_TRUE(source.opens_comment(2));
+
+    EXPECT_EQ(source.window(2), "/* a\nb */\n");
+    EXPECT_FALSE(source.opens_comment(1));
+}
+
+TEST(Stream_source_test, Rest_reaches_the_end_of_the_input)
+{
+    std::istringstream stream{"a\r\nb /* c\r\nd */\r\ne\r\n"};
+
+    Stream_source source{stream, 3};
+
+    EXPECT_EQ(source.window(0), "a\n");
+    EXPECT_EQ(source.rest(2), "b /* c\nd */\ne\n");
+    EXPECT_TRUE(source.exhausted());
+    EXPECT_EQ(source.rest(15), std::nullopt);
+}
+
+TEST(Stream_source_test, Block_comments_lex_as_in_memory)
+{
+    const std::string input{"/* a */\nx\n/* b */\ny\nmodule m { /* c */ };\n// d */\nz\n"};
+
+    Token_reader memory{Lexer_factory::build(), input};
+
+    const auto expected{read_all(memory)};
+
+    ASSERT_EQ(expected.front().first, Token_kind::Multi_line_comment);
+
+    for (const std::size_t chunk_size : {1UL, 2UL, 4UL, 7UL, 64UL})
+    {
+        std::istringstream stream{input};
+
+        Token_reader streamed{Lexer_factory::build(), Stream_source{stream, chunk_size}};
+
+        EXPECT_EQ(read_all(streamed), expected) << "chunk size " << chunk_size;
+    }
+}
+
+TEST(Stream_source_test, Memory_is_bounded_by_chunk_and_line)
+{
+    constexpr std::size_t chunk_size{256};
+
+    const std::string line{"interface i { void f(in long a); };\n"};
+
+    std::string input;
+
+    for (std::size_t i{0}; i < 10'000; ++i)
+    {
+        input += line;
+    }
+
+    std::istringstream stream{input};
+
+    Stream_source source{stream, chunk_size};
+
+    std::size_t total{0};
+
+    for (std::size_t consumed{0};;)
+    {
+        const auto window{source.window(consumed)};
+
+        if (!window)
+        {
+            break;
+        }
+
+        EXPECT_LE(source.buffered(), chunk_size + line.size());
+
+        consumed = window->size();
+
+        total += consumed;
+    }
+
+    EXPECT_EQ(total, input.size());
+}
+
+TEST(Stream_source_test, Reads_from_file_descriptor)
+{
+    int descriptors[2];
+    ASSERT_EQ(::pipe(descriptors), 0);
+
+    const std::string input{"module m\r\n{\r\n};"};
+    ASSERT_EQ(::write(descriptors[1], input.data(), input.size()), static_cast<ssize_t>(input.size()));
+    ::close(descriptors[1]);
+
+    Stream_source source{descriptors[0], 5};
+
+    EXPECT_EQ(source.window(0), "module m\n");
+    EXPECT_EQ(source.window(9), "{\n");
+    EXPECT_EQ(source.window(2), "};");
+    EXPECT_EQ(source.window(2), std::nullopt);
+
+    ::close(descriptors[0]);
+}
+
+TEST(Stream_source_test, Rejects_empty_chunks)
+{
+    std::istringstream stream;
+
+    EXPECT_THROW(Stream_source(stream, 0), std::invalid_argument);
+}
@@ -0,0 +1,201 @@
+#include "parser/idl/symbol_table.hpp"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "parser/idl/concurrent_symbol_table.hpp"
+#include "parser/idl/lexer_factory.hpp"
+#include "parser/idl/token_batch.hpp"
+#include "parser/idl/token_reader.hpp"
+
+using namespace parser::idl;
+
+namespace
+{
+std::string numbered(const std::string_view prefix, const int number)
+{
+    std::string name{prefix};
+
+    name += std::to_string(number);
+
+    return name;
+}
+
+} // namespace
+
+static_assert(well_known("TRUE") == 0);
+static_assert(well_known("ValueBase") == 3);
+
+TEST(Symbol_table_test, Starts_with_well_known_names_and_seeds)
+{
+    const std::vector<std::string_view> seeds{"Custom", "Object", "Other"};
+
+    Symbol_table symbols{seeds};
+
+    ASSERT_EQ(symbols.size(), well_known_symbols.size() + 2);
+    EXPECT_EQ(symbols.find("Object"), well_known("Object"));
+    EXPECT_EQ(symbols.find("Custom"), well_known_symbols.size());
+    EXPECT_EQ(symbols.spelling(well_known("FALSE")), "FALSE");
+    EXPECT_FALSE(symbols.find("Missing").has_value());
+}
+
+TEST(Symbol_table_test, Interns_dense_ids_that_outlive_the_source)
+{
+    Symbol_table symbols;
+
+    std::vector<Symbol_id> ids;
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        const auto name{numbered("name_", i)};
+
+        ids.push_back(symbols.intern(name));
+    }
+
+    ASSERT_EQ(symbols.size(), well_known_symbols.size() + 10000);
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        const auto name{numbered("name_", i)};
+
+        EXPECT_EQ(ids[i], well_known_symbols.size() + i);
+        EXPECT_EQ(symbols.intern(name), ids[i]);
+        EXPECT_EQ(symbols.spelling(ids[i]), name);
+    }
+
+    EXPECT_EQ(symbols.size(), well_known_symbols.size() + 10000);
+}
+
+TEST(Symbol_table_test, Concurrent_interning_agrees_across_threads)
+{
+    Concurrent_symbol_table symbols;
+
+    constexpr int threads{8};
+
+    constexpr int names{5000};
+
+    std::vector<std::vector<Symbol_id>> ids(threads, std::vector<Symbol_id>(names));
+    {
+        std::vector<std::jthread> workers;
+
+        for (int thread = 0; thread < threads; ++thread)
+        {
+            workers.emplace_back(
+                    [&symbols, &ids, thread]
+                    {
+                        // Every thread interns the same names in a different order.
+                        for (int i = 0; i < names; ++i)
+                        {
+                            const auto index{(i * 7 + thread * 613) % names};
+
+                            ids[thread][index] = symbols.intern(numbered("n", index));
+                        }
+                    });
+        }
+    }
+
+    ASSERT_EQ(symbols.size(), well_known_symbols.size() + names);
+
+    std::set<Symbol_id> distinct;
+
+    for (int i = 0; i < names; ++i)
+    {
+        for (int thread = 1; thread < threads; ++thread)
+        {
+            ASSERT_EQ(ids[thread][i], ids[0][i]);
+        }
+
+        EXPECT_EQ(symbols.spelling(ids[0][i]), numbered("n", i));
+
+        distinct.insert(ids[0][i]);
+    }
+
+    EXPECT_EQ(distinct.size(), names);
+    EXPECT_EQ(*distinct.begin(), well_known_symbols.size());
+    EXPECT_EQ(*distinct.rbegin(), well_known_symbols.size() + names - 1);
+    EXPECT_EQ(symbols.find("Object"), well_known("Object"));
+}
+
+TEST(Symbol_table_test, Reader_interns_identifiers)
+{
+    Symbol_table symbols;
+
+    Token_reader reader{Lexer_factory::build(), std::string{"struct a { Object b; a c; };"}};
+
+    reader.attach_symbols(symbols);
+
+    const auto checkpoint{reader.mark()};
+
+    std::vector<Symbol_id> streamed;
+
+    for (auto expected{reader.next()}; expected && expected.value(); expected = reader.next())
+    {
+        ASSERT_TRUE(reader.peek().has_value());
+
+        streamed.push_back(reader.symbol());
+    }
+
+    reader.rewind(checkpoint);
+
+    ASSERT_TRUE(reader.peek(1).has_value());
+    EXPECT_EQ(reader.symbol(0), no_symbol);
+    EXPECT_EQ(reader.symbol(1), streamed[0]);
+
+    const auto a{symbols.find("a")};
+    ASSERT_TRUE(a.has_value());
+    EXPECT_EQ(symbols.size(), well_known_symbols.size() + 3);
+
+    const auto tape{reader.tape()};
+    ASSERT_TRUE(tape.has_value());
+    ASSERT_EQ(tape->size(), 11);
+    EXPECT_EQ(tape->symbol(0), no_symbol);
+    EXPECT_EQ(tape->symbol(1), *a);
+    EXPECT_EQ(tape->symbol(3), well_known("Object"));
+    EXPECT_EQ(tape->symbol(6), *a);
+    EXPECT_EQ(symbols.size(), well_known_symbols.size() + 3);
+}
+
+TEST(Symbol_table_test, Batch_shares_one_table)
+{
+    const auto directory{std::filesystem::temp_directory_path()};
+
+    std::vector<std::filesystem::path> files;
+
+    for (int i = 0; i < 6; ++i)
+    {
+        files.push_back(directory / (numbered("symbol_batch_", i) + ".idl"));
+
+        std::ofstream file{files.back()};
+
+        file << "struct s" << i << " { shared a; local_" << i << " b; };\n";
+    }
+
+    Concurrent_symbol_table symbols;
+
+    Token_batch batch{Lexer_factory::build(), 3};
+
+    batch.attach_symbols(symbols);
+
+    const auto results{batch.tokenize(files)};
+
+    const auto shared{symbols.find("shared")};
+    ASSERT_TRUE(shared.has_value());
+
+    for (std::size_t i = 0; i < files.size(); ++i)
+    {
+        ASSERT_TRUE(results[i].has_value());
+        EXPECT_EQ(results[i]->symbol(3), *shared);
+        EXPECT_EQ(symbols.spelling(results[i]->symbol(6)), numbered("local_", static_cast<int>(i)));
+
+        std::filesystem::remove(files[i]);
+    }
+
+    // Per file: s<i> and local_<i>, plus the identifiers a, b and shared common to all of them.
+    EXPECT_EQ(symbols.size(), well_known_symbols.size() + 2 * files.size() + 3);
+}
@@ -0,0 +1,175 @@
+#include "parser/idl/token_document.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "parser/idl/lexer_factory.hpp"
+#include "parser/idl/tokens.hpp"
+
+using namespace parser::idl;
+
+namespace
+{
+void expect_same_tokens(const Token_document& document, const Token_document& expected)
+{
+    ASSERT_EQ(document.text(), expected.text());
+    ASSERT_EQ(document.size(), expected.size()) << document.text();
+    ASSERT_EQ(document.lexed(), expected.lexed());
+    ASSERT_EQ(document.error().has_value(), expected.error().has_value());
+
+    if (document.error())
+    {
+        ASSERT_EQ(document.error()->position(), expected.error()->position());
+    }
+
+    for (std::size_t index{0}; index < document.size(); ++index)
+    {
+        ASSERT_EQ(document.kind(index), expected.kind(index)) << index;
+        ASSERT_EQ(document.offset(index), expected.offset(index)) << index;
+        ASSERT_EQ(document.lexeme(index), expected.lexeme(index)) << index;
+        ASSERT_EQ(document.line(index), expected.line(index)) << index;
+        ASSERT_EQ(document.column(index), expected.column(index)) << index;
+    }
+}
+
+std::string make_module(const std::size_t interfaces)
+{
+    std::string text{"module m {\n"};
+
+    for (std::size_t index{0}; index < interfaces; ++index)
+    {
+        const auto name{std::to_string(index)};
+
+        text += "  // interface " + name + "\n";
+        text += "  interface i" + name + " {\n";
+        text += "    attribute long a" + name + "; // counter\n";
+        text += "    void f" + name + "(in string s, out double d) raises (e);\n";
+        text += "  };\n";
+    }
+
+    return text + "};\n";
+}
+
+} // namespace
+
+TEST(Token_document_test, Load_matches_token_stream)
+{
+    const Token_document document{Lexer_factory::build(), "module m { const long x = 42; };\n"};
+
+    ASSERT_FALSE(document.error().has_value());
+    ASSERT_EQ(document.size(), 20);
+
+    EXPECT_EQ(document.kind(0), Token_kind::Keyword_module);
+    EXPECT_EQ(document.kind(1), Token_kind::Whitespace);
+    EXPECT_EQ(document.lexeme(2), "m");
+    EXPECT_EQ(document.kind(19), Token_kind::Newline);
+    EXPECT_EQ(document.lexed(), document.text().size());
+}
+
+TEST(Token_document_test, Edit_relexes_only_the_changed_line)
+{
+    Token_document document{Lexer_factory::build(), make_module(1'000)};
+
+    const auto size{document.size()};
+
+    const auto offset{document.text().find("a500;")};
+
+    const auto edit{document.replace(offset, 4, "renamed")};
+    ASSERT_TRUE(edit.has_value());
+
+    EXPECT_EQ(document.size(), size);
+    EXPECT_LE(edit->removed, 16);
+    EXPECT_EQ(edit->removed, edit->inserted);
+
+    expect_same_tokens(document, Token_document{Lexer_factory::build(), document.text()});
+}
+
+TEST(Token_document_test, Edits_match_full_relex)
+{
+    constexpr std::string_view fragments[]{
+            "",   "x",  " ",        "\n", "\n\n",   ";",  "{ }",  "module", "1.5e3", "42",   "\"s\"",
+            "\"", "/*", "*/",       "//", "long ", "i0", "a b", "@",      "-",     "/",    "*",
+    };
+
+    std::mt19937 random{20250101};
+
+    Token_document document{Lexer_factory::build(), make_module(8)};
+
+    for (std::size_t step{0}; step < 2'000; ++step)
+    {
+        const auto size{document.text().size()};
+
+        const auto offset{std::uniform_int_distribution<std::size_t>{0, size}(random)};
+
+        const auto length{std::uniform_int_distribution<std::size_t>{0, std::min<std::size_t>(size - offset, 6)}(random)};
+
+        const auto fragment{fragments[std::uniform_int_distribution<std::size_t>{0, std::size(fragments) - 1}(random)]};
+
+        const auto edit{document.replace(offset, length, fragment)};
+
+        const Token_document expected{Lexer_factory::build(), document.text()};
+
+        EXPECT_EQ(edit.has_value() && !document.error(), !expected.error().has_value()) << "step " << step;
+
+        expect_same_tokens(document, expected);
+
+        if (HasFatalFailure())
+        {
+            FAIL() << "step " << step << ": replace(" << offset << ", " << length << ", \"" << fragment << "\")";
+        }
+    }
+}
+
+TEST(Token_document_test, Comment_delimiter_edit_relexes_everything)
+{
+    Token_document document{Lexer_factory::build(), "long a; /* note */ long b;\nlong c;\n"};
+
+    const auto size{document.size()};
+
+    const auto removed{document.replace(document.text().find("*/"), 2, "")};
+    ASSERT_TRUE(removed.has_value());
+
+    EXPECT_EQ(removed->first, 0);
+    EXPECT_EQ(removed->removed, size);
+
+    expect_same_tokens(document, Token_document{Lexer_factory::build(), document.text()});
+
+    const auto restored{document.replace(document.text().find("note") + 4, 0, " */")};
+    ASSERT_TRUE(restored.has_value());
+
+    EXPECT_EQ(document.size(), size);
+    EXPECT_EQ(document.kind(5), Token_kind::Multi_line_comment);
+
+    expect_same_tokens(document, Token_document{Lexer_factory::build(), document.text()});
+}
+
+TEST(Token_document_test, Error_position_is_a_text_offset)
+{
+    Token_document document{Lexer_factory::build(), "long a;\nlong b;\nlong @c;\n"};
+
+    ASSERT_TRUE(document.error().has_value());
+    EXPECT_EQ(document.error()->position(), document.text().find('@'));
+
+    ASSERT_TRUE(document.replace(document.text().find('a'), 1, "abc").has_value());
+
+    ASSERT_TRUE(document.error().has_value());
+    EXPECT_EQ(document.error()->position(), document.text().find('@'));
+
+    (void) document.replace(document.text().find("long @"), 0, "\n");
+
+    ASSERT_TRUE(document.error().has_value());
+    EXPECT_EQ(document.error()->position(), document.text().find('@'));
+}
+
+TEST(Token_document_test, Rejects_edits_outside_the_text)
+{
+    Token_document document{Lexer_factory::build(), "long a;"};
+
+    EXPECT_THROW((void) document.replace(8, 0, "x"), std::out_of_range);
+    EXPECT_THROW((void) document.replace(3, 5, "x"), std::out_of_range);
+}
@@ -0,0 +1,62 @@
+#include "parser/idl/token_range.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iterator>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "parser/idl/lexer_factory.hpp"
+#include "parser/idl/token_reader.hpp"
+
+using namespace parser::idl;
+
+static_assert(std::ranges::input_range<Token_range>);
+static_assert(std::ranges::view<Token_range>);
+
+TEST(Token_range_test, Composes_with_views)
+{
+    Token_reader reader{Lexer_factory::build(), std::string{"module m { /* c */ struct s { long a; }; };\n"}};
+
+    Token_range tokens{reader};
+
+    std::vector<std::string_view> identifiers;
+
+    for (const auto& token : tokens | std::views::filter([](const auto& token) {
+             return token.kind() == Token_kind::Identifier;
+         }))
+    {
+        identifiers.push_back(token.lexeme());
+    }
+
+    EXPECT_EQ(identifiers, (std::vector<std::string_view>{"m", "s", "a"}));
+    EXPECT_FALSE(tokens.error().has_value());
+
+    reader.reset();
+
+    const auto braces{std::ranges::count_if(
+            Token_range{reader}, [](const auto& token) { return token.kind() == Token_kind::Symbol_lbrace; })};
+
+    EXPECT_EQ(braces, 2);
+}
+
+TEST(Token_range_test, Ends_at_lexical_error)
+{
+    Token_reader reader{Lexer_factory::build(), std::string{"const long x = $;"}};
+
+    Token_range tokens{reader};
+
+    std::vector<Token_kind> kinds;
+
+    std::ranges::transform(tokens, std::back_inserter(kinds), [](const auto& token) { return token.kind(); });
+
+    EXPECT_EQ(kinds.size(), 4);
+
+    const auto error{tokens.error()};
+
+    ASSERT_TRUE(error.has_value());
+    EXPECT_EQ(error->position(), 15);
+}
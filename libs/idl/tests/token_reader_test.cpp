@@ -5,6 +5,10 @@
 #include <exception>
 #include <filesystem>
 #include <fstream>
+#include <memory>
+#include <span>
+#include <sstream>
+#include <stdexcept>
 #include <lexer/core/builder.hpp>
 #include <lexer/regex/any_of.hpp>
 #include <lexer/regex/choice.hpp>
@@ -13,7 +17,11 @@
 #include <lexer/regex/text.hpp>
 #include <lexer/tools/tokenizer/tokenizer.hpp>
 #include <string>
+#include <string_view>
+#include <vector>
 
+#include "parser/idl/tape_cursor.hpp"
+#include "parser/idl/token_batch.hpp"
 #include "parser/idl/token_reader.hpp"
 #include "parser/idl/tokens.hpp"
 
@@ -185,6 +193,49 @@ TEST_F(Token_reader_test, Tokenize_from_string_stream)
     evaluate();
 }
 
+TEST_F(Token_reader_test, Load_adopts_or_borrows_caller_buffers)
+{
+    const auto first_lexeme{[](Token_reader& reader) {
+        const auto expected{reader.next()};
+
+        return expected && *expected ? expected->value().lexeme() : std::string_view{};
+    }};
+
+    {
+        std::string input{"boolean identifier\n1234"};
+
+        const auto* const data{input.data()};
+
+        Token_reader reader{build_lexer(), std::move(input)};
+
+        const auto lexeme{first_lexeme(reader)};
+        EXPECT_EQ(lexeme, "boolean");
+        EXPECT_EQ(lexeme.data(), data); // LF input is adopted, not copied
+    }
+
+    {
+        auto payload{std::make_unique<std::string>("boolean x\r\n1234 y")};
+
+        Token_reader reader{build_lexer(), std::string_view{*payload}};
+
+        payload.reset(); // The buffer is only read during load()
+
+        EXPECT_EQ(first_lexeme(reader), "boolean");
+        EXPECT_EQ(first_lexeme(reader), "x");
+        EXPECT_EQ(first_lexeme(reader), "1234");
+        EXPECT_EQ(reader.location().line(), 2);
+        EXPECT_EQ(reader.location().column(), 5);
+
+        const std::vector<char> bytes{'c', 'h', 'a', 'r', '\r', 'z'};
+
+        reader.load(std::span<const char>{bytes});
+
+        EXPECT_EQ(first_lexeme(reader), "char");
+        EXPECT_EQ(first_lexeme(reader), "z");
+        EXPECT_EQ(reader.location().line(), 2);
+    }
+}
+
 TEST_F(Token_reader_test, Tokenize_from_file_stream)
 {
     const auto path{std::filesystem::temp_directory_path() / "tokenizer_stream_test.idl"};
@@ -245,6 +296,58 @@ TEST_F(Token_reader_test, Tokenize_from_file_stream)
     std::filesystem::remove(path);
 }
 
+TEST_F(Token_reader_test, Mapped_file_is_normalized)
+{
+    const auto path{std::filesystem::temp_directory_path() / "tokenizer_mapped_crlf_test.idl"};
+    {
+        std::ofstream out{path, std::ios::binary};
+
+        ASSERT_TRUE(out.is_open());
+
+        out << "boolean\r\nx\r1234";
+    }
+
+    const auto empty{std::filesystem::temp_directory_path() / "tokenizer_mapped_empty_test.idl"};
+    {
+        std::ofstream out{empty, std::ios::binary};
+
+        ASSERT_TRUE(out.is_open());
+    }
+
+    auto lexer{build_lexer()};
+
+    Token_reader reader{std::move(lexer), path};
+
+    const auto advance = [&reader](const Token_kind expect_kind, const std::string_view expect_lexeme) {
+        const auto expected{reader.next()};
+        ASSERT_TRUE(expected.has_value());
+
+        const auto& optional{expected.value()};
+        ASSERT_TRUE(optional.has_value());
+
+        const auto& token{optional.value()};
+        EXPECT_EQ(token.kind(), expect_kind);
+        EXPECT_EQ(token.lexeme(), expect_lexeme);
+    };
+
+    advance(Token_kind::Keyword_boolean, "boolean");
+    advance(Token_kind::Identifier, "x");
+    advance(Token_kind::Integer_literal, "1234");
+    EXPECT_EQ(reader.location().line(), 3);
+    EXPECT_EQ(reader.location().offset(), 14);
+
+    reader.load(empty);
+
+    const auto expected{reader.next()};
+    ASSERT_TRUE(expected.has_value());
+
+    const auto& optional{expected.value()};
+    EXPECT_FALSE(optional.has_value()); // EOF
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(empty);
+}
+
 TEST_F(Token_reader_test, Fails_to_open_file)
 {
     const auto missing_file{std::filesystem::temp_directory_path() / "nonexistent_lexer_input.idl"};
@@ -399,6 +502,58 @@ TEST_F(Token_reader_test, Peek_is_stable_until_next)
     EXPECT_FALSE(optional.has_value()); // EOF
 }
 
+TEST_F(Token_reader_test, Peek_ahead_multiple_tokens)
+{
+    const std::string input{"boolean x\n 1234 y"};
+
+    auto lexer{build_lexer()};
+
+    Token_reader reader{std::move(lexer), input};
+
+    const auto peek = [&reader](
+                              const std::size_t n, const Token_kind expect_kind, const std::string_view expect_lexeme) {
+        const auto expected{reader.peek(n)};
+        ASSERT_TRUE(expected.has_value());
+
+        const auto& optional{expected.value()};
+        ASSERT_TRUE(optional.has_value());
+
+        const auto& token{optional.value()};
+        EXPECT_EQ(token.kind(), expect_kind);
+        EXPECT_EQ(token.lexeme(), expect_lexeme);
+    };
+
+    peek(2, Token_kind::Integer_literal, "1234");
+    peek(0, Token_kind::Keyword_boolean, "boolean");
+    peek(1, Token_kind::Identifier, "x");
+    peek(3, Token_kind::Identifier, "y");
+
+    EXPECT_EQ(reader.location(0).offset(), 7);
+    EXPECT_EQ(reader.location(2).line(), 2);
+    EXPECT_EQ(reader.location(2).column(), 6);
+    EXPECT_EQ(reader.location(3).offset(), 17);
+
+    EXPECT_THROW((void)reader.peek(Token_lookahead::capacity), std::out_of_range);
+
+    ASSERT_TRUE(reader.next().has_value()); // boolean
+
+    peek(0, Token_kind::Identifier, "x");
+    peek(2, Token_kind::Identifier, "y");
+
+    {
+        const auto expected{reader.peek(3)};
+        ASSERT_TRUE(expected.has_value());
+
+        const auto& optional{expected.value()};
+        EXPECT_FALSE(optional.has_value()); // EOF
+    }
+
+    reader.reset();
+
+    peek(1, Token_kind::Identifier, "x");
+    peek(0, Token_kind::Keyword_boolean, "boolean");
+}
+
 TEST_F(Token_reader_test, Next_is_idempotent_at_eof)
 {
     const std::string input{"boolean"};
@@ -471,3 +626,450 @@ TEST_F(Token_reader_test, Multiline_comment_updates_location)
         EXPECT_EQ(location.offset(), 12);
     }
 }
+
+TEST_F(Token_reader_test, Lazy_locations_match_eager)
+{
+    const std::string input{
+            "boolean x\r\n"
+            "/* a\nb\r\nc */ 1234\r"
+            "// comment\n"
+            "\n"
+            "string y 5.0e+1"};
+
+    Token_reader eager{build_lexer(), input};
+
+    Token_reader lazy{build_lexer(), input, Location_mode::Lazy};
+
+    for (;;)
+    {
+        const auto eager_expected{eager.next()};
+        const auto lazy_expected{lazy.next()};
+        ASSERT_TRUE(eager_expected.has_value());
+        ASSERT_TRUE(lazy_expected.has_value());
+
+        const auto& eager_optional{eager_expected.value()};
+        const auto& lazy_optional{lazy_expected.value()};
+        ASSERT_EQ(eager_optional.has_value(), lazy_optional.has_value());
+
+        if (!eager_optional)
+        {
+            break; // EOF
+        }
+
+        EXPECT_EQ(eager_optional->kind(), lazy_optional->kind());
+        EXPECT_EQ(eager_optional->lexeme(), lazy_optional->lexeme());
+
+        EXPECT_EQ(eager.location().line(), lazy.location().line());
+        EXPECT_EQ(eager.location().column(), lazy.location().column());
+        EXPECT_EQ(eager.location().offset(), lazy.location().offset());
+    }
+
+    lazy.reset();
+
+    ASSERT_TRUE(lazy.next().has_value());
+    EXPECT_EQ(lazy.location().line(), 1);
+    EXPECT_EQ(lazy.location().column(), 8);
+}
+
+TEST_F(Token_reader_test, Tape_matches_token_stream)
+{
+    const std::string input{
+            "boolean x 1234 \"hello\" 3.14 // comment\r\n"
+            "string y 5.0e+1 /* block */"};
+
+    auto lexer{build_lexer()};
+
+    Token_reader reader{std::move(lexer), input};
+
+    const auto tape{reader.tape()};
+    ASSERT_TRUE(tape.has_value());
+    ASSERT_EQ(tape->size(), 10);
+
+    for (std::size_t index = 0; index < tape->size(); ++index)
+    {
+        const auto expected{reader.next()};
+        ASSERT_TRUE(expected.has_value());
+
+        const auto& optional{expected.value()};
+        ASSERT_TRUE(optional.has_value());
+
+        EXPECT_EQ(tape->kind(index), optional->kind());
+        EXPECT_EQ(tape->lexeme(index), optional->lexeme());
+    }
+
+    EXPECT_EQ(tape->line(6), 2); // 'string'
+    EXPECT_EQ(tape->column(6), 1);
+    EXPECT_EQ(tape->offset(6), 39);
+    EXPECT_EQ(tape->column(7), 8); // 'y'
+
+    Tape_cursor cursor{*tape};
+
+    EXPECT_EQ(cursor.kind(), Token_kind::Keyword_boolean);
+    EXPECT_EQ(cursor.peek(3)->lexeme(), "\"hello\"");
+
+    const auto mark{cursor.position()};
+
+    EXPECT_EQ(cursor.next()->lexeme(), "boolean");
+    EXPECT_EQ(cursor.next()->lexeme(), "x");
+
+    cursor.seek(mark);
+
+    EXPECT_EQ(cursor.next()->lexeme(), "boolean");
+
+    cursor.seek(tape->size() - 1);
+
+    EXPECT_EQ(cursor.next()->kind(), Token_kind::Multi_line_comment);
+    EXPECT_TRUE(cursor.at_end());
+    EXPECT_FALSE(cursor.next().has_value());
+    EXPECT_FALSE(cursor.kind().has_value());
+}
+
+TEST_F(Token_reader_test, Tape_reports_lexical_error)
+{
+    const std::string input{"boolean$"}; // '$' not recognized by the grammar
+
+    auto lexer{build_lexer()};
+
+    Token_reader reader{std::move(lexer), input};
+
+    const auto tape{reader.tape()};
+    ASSERT_FALSE(tape.has_value());
+    EXPECT_EQ(tape.error().position(), 7);
+
+    const auto expected{reader.next()};
+    ASSERT_TRUE(expected.has_value());
+    EXPECT_EQ(expected.value()->lexeme(), "boolean");
+}
+
+TEST_F(Token_reader_test, Mark_and_rewind_replay_tokens)
+{
+    const std::string input{"boolean x\n1234 y string"};
+
+    auto lexer{build_lexer()};
+
+    Token_reader reader{std::move(lexer), input};
+
+    const auto advance = [&reader](const Token_kind expect_kind, const std::string_view expect_lexeme) {
+        const auto expected{reader.next()};
+        ASSERT_TRUE(expected.has_value());
+
+        const auto& optional{expected.value()};
+        ASSERT_TRUE(optional.has_value());
+
+        const auto& token{optional.value()};
+        EXPECT_EQ(token.kind(), expect_kind);
+        EXPECT_EQ(token.lexeme(), expect_lexeme);
+    };
+
+    advance(Token_kind::Keyword_boolean, "boolean");
+
+    const auto outer{reader.mark()};
+
+    advance(Token_kind::Identifier, "x");
+
+    const auto inner{reader.mark()};
+
+    advance(Token_kind::Integer_literal, "1234");
+    advance(Token_kind::Identifier, "y");
+
+    reader.rewind(inner);
+
+    {
+        const auto expected{reader.peek(1)};
+        ASSERT_TRUE(expected.has_value());
+        EXPECT_EQ(expected.value()->lexeme(), "y");
+    }
+
+    EXPECT_EQ(reader.location(0).line(), 2);
+    EXPECT_EQ(reader.location(0).column(), 5); // after '1234'
+
+    advance(Token_kind::Integer_literal, "1234");
+    advance(Token_kind::Identifier, "y");
+    EXPECT_EQ(reader.location().line(), 2);
+    EXPECT_EQ(reader.location().column(), 7);
+
+    reader.rewind(outer);
+
+    advance(Token_kind::Identifier, "x");
+    advance(Token_kind::Integer_literal, "1234");
+
+    const auto committed{reader.mark()};
+
+    advance(Token_kind::Identifier, "y");
+
+    reader.release(committed);
+
+    advance(Token_kind::Keyword_string, "string");
+    EXPECT_EQ(reader.location().offset(), 23);
+
+    const auto expected{reader.next()};
+    ASSERT_TRUE(expected.has_value());
+
+    const auto& optional{expected.value()};
+    EXPECT_FALSE(optional.has_value()); // EOF
+}
+
+TEST_F(Token_reader_test, Load_and_reset_drop_checkpoints)
+{
+    Token_reader reader{build_lexer(), std::string{"boolean x 1234"}};
+
+    const auto lexeme = [&reader] {
+        const auto expected{reader.next()};
+
+        return expected && *expected ? std::string{expected->value().lexeme()} : std::string{};
+    };
+
+    const auto replayed{reader.mark()};
+
+    EXPECT_EQ(lexeme(), "boolean");
+    EXPECT_EQ(lexeme(), "x");
+
+    reader.rewind(replayed);
+
+    // Loading while the rewind is still replaying must not replay tokens of the old input.
+    reader.load(std::string{"char long_identifier_longer_than_sso 5678"});
+
+    EXPECT_EQ(lexeme(), "char");
+    EXPECT_EQ(lexeme(), "long_identifier_longer_than_sso");
+    EXPECT_EQ(lexeme(), "5678");
+    EXPECT_EQ(lexeme(), "");
+
+    // A checkpoint taken before `tape()` (which resets the reader) is ignored afterwards.
+    reader.reset();
+
+    const auto stale{reader.mark()};
+
+    EXPECT_EQ(lexeme(), "char");
+
+    ASSERT_TRUE(reader.tape().has_value());
+
+    reader.rewind(stale);
+    reader.release(stale);
+
+    const auto fresh{reader.mark()};
+
+    EXPECT_EQ(lexeme(), "char");
+    EXPECT_EQ(lexeme(), "long_identifier_longer_than_sso");
+
+    reader.rewind(fresh);
+
+    EXPECT_EQ(lexeme(), "char");
+    EXPECT_EQ(lexeme(), "long_identifier_longer_than_sso");
+    EXPECT_EQ(lexeme(), "5678");
+    EXPECT_EQ(lexeme(), "");
+}
+
+TEST_F(Token_reader_test, Fast_path_matches_peek_and_next)
+{
+    const std::string input{"boolean x\n1234 y$"}; // '$' not recognized by the grammar
+
+    auto lexer{build_lexer()};
+
+    Token_reader reader{std::move(lexer), input};
+
+    const auto* token{reader.current()};
+    ASSERT_NE(token, nullptr);
+    EXPECT_EQ(token->kind(), Token_kind::Keyword_boolean);
+    EXPECT_EQ(reader.current(), token);
+
+    EXPECT_TRUE(reader.check(Token_kind::Keyword_boolean));
+    EXPECT_FALSE(reader.accept(Token_kind::Identifier));
+    EXPECT_TRUE(reader.accept(Token_kind::Keyword_boolean));
+
+    const auto checkpoint{reader.mark()};
+
+    EXPECT_FALSE(reader.expect(Token_kind::Integer_literal).has_value());
+
+    const auto identifier{reader.expect(Token_kind::Identifier)};
+    ASSERT_TRUE(identifier.has_value());
+    EXPECT_EQ(identifier->lexeme(), "x");
+
+    EXPECT_TRUE(reader.accept(Token_kind::Integer_literal));
+
+    reader.rewind(checkpoint);
+
+    EXPECT_TRUE(reader.accept(Token_kind::Identifier));
+    EXPECT_TRUE(reader.check(Token_kind::Integer_literal));
+    EXPECT_EQ(reader.location().line(), 2);
+    EXPECT_EQ(reader.location().column(), 5); // after the replayed '1234'
+
+    const auto next{reader.next()};
+    ASSERT_TRUE(next.has_value());
+    EXPECT_EQ(next.value()->lexeme(), "1234");
+
+    EXPECT_TRUE(reader.accept(Token_kind::Identifier));
+
+    EXPECT_EQ(reader.current(), nullptr);
+    EXPECT_FALSE(reader.check(Token_kind::Identifier));
+
+    const auto error{reader.peek()};
+    ASSERT_FALSE(error.has_value());
+    EXPECT_EQ(error.error().position(), 16);
+}
+
+TEST_F(Token_reader_test, Batch_tokenizes_files_in_input_order)
+{
+    const auto directory{std::filesystem::temp_directory_path()};
+
+    const std::vector<std::filesystem::path> files{
+            directory / "tokenizer_batch_small.idl", directory / "tokenizer_batch_missing.idl",
+            directory / "tokenizer_batch_large.idl", directory / "tokenizer_batch_error.idl"};
+
+    std::filesystem::remove(files[1]);
+    {
+        std::ofstream small{files[0]};
+        std::ofstream large{files[2]};
+        std::ofstream error{files[3]};
+
+        small << "boolean x";
+
+        for (int i = 0; i < 100; ++i)
+        {
+            large << "string y" << i << "\n";
+        }
+
+        error << "char\n  $";
+    }
+
+    Token_batch batch{build_lexer(), 3};
+
+    const auto results{batch.tokenize(files)};
+    ASSERT_EQ(results.size(), files.size());
+
+    ASSERT_TRUE(results[0].has_value());
+    ASSERT_EQ(results[0]->size(), 2);
+    EXPECT_EQ(results[0]->lexeme(1), "x");
+
+    ASSERT_FALSE(results[1].has_value());
+    EXPECT_EQ(results[1].error().file, files[1]);
+
+    ASSERT_TRUE(results[2].has_value());
+    EXPECT_EQ(results[2]->size(), 200);
+    EXPECT_EQ(results[2]->lexeme(199), "y99");
+    EXPECT_EQ(results[2]->line(199), 100);
+
+    ASSERT_FALSE(results[3].has_value());
+    EXPECT_EQ(results[3].error().offset, 7);
+    EXPECT_EQ(results[3].error().line, 2);
+    EXPECT_EQ(results[3].error().column, 3);
+
+    EXPECT_EQ(Token_batch::schedule(files).front(), 2);
+
+    for (const auto& file : files)
+    {
+        std::filesystem::remove(file);
+    }
+}
+
+TEST_F(Token_reader_test, Readers_share_one_compiled_lexer)
+{
+    const auto lexer{std::make_shared<const Lexer>(build_lexer())};
+
+    Token_reader first{lexer};
+
+    Token_reader second{lexer, Location_mode::Lazy};
+
+    first.load(std::string{"boolean x"});
+
+    second.load(std::string{"char y"});
+
+    const auto expected_first{first.next()};
+    ASSERT_TRUE(expected_first.has_value());
+    EXPECT_EQ(expected_first.value()->kind(), Token_kind::Keyword_boolean);
+
+    const auto expected_second{second.next()};
+    ASSERT_TRUE(expected_second.has_value());
+    EXPECT_EQ(expected_second.value()->kind(), Token_kind::Keyword_char);
+}
+
+TEST_F(Token_reader_test, Streamed_input_matches_in_memory_input)
+{
+    const std::string input{
+            "boolean x\r\n"
+            "/* a\nb\r\nc */ 1234\r"
+            "// comment\r\n"
+            "\n"
+            "string a_rather_long_identifier_name 5.0e+1\r\n"
+            "char \"quoted text\" 3.25"};
+
+    for (std::size_t chunk_size{1}; chunk_size <= 16; ++chunk_size)
+    {
+        Token_reader memory{build_lexer(), input};
+
+        std::istringstream stream{input};
+
+        Token_reader streamed{build_lexer(), Stream_source{stream, chunk_size}};
+
+        for (std::size_t index{0};; ++index)
+        {
+            if (index % 3 == 0)
+            {
+                (void) memory.peek(2);
+                (void) streamed.peek(2); // buffer tokens across windows
+            }
+
+            const auto memory_expected{memory.next()};
+            const auto streamed_expected{streamed.next()};
+            ASSERT_TRUE(memory_expected.has_value());
+            ASSERT_TRUE(streamed_expected.has_value()) << "chunk size " << chunk_size;
+
+            const auto& memory_optional{memory_expected.value()};
+            const auto& streamed_optional{streamed_expected.value()};
+            ASSERT_EQ(memory_optional.has_value(), streamed_optional.has_value()) << "chunk size " << chunk_size;
+
+            if (!memory_optional)
+            {
+                break; // EOF
+            }
+
+            EXPECT_EQ(memory_optional->kind(), streamed_optional->kind());
+            EXPECT_EQ(memory_optional->lexeme(), streamed_optional->lexeme()) << "chunk size " << chunk_size;
+
+            EXPECT_EQ(memory.location().line(), streamed.location().line());
+            EXPECT_EQ(memory.location().column(), streamed.location().column());
+            EXPECT_EQ(memory.location().offset(), streamed.location().offset());
+        }
+    }
+}
+
+TEST_F(Token_reader_test, Streamed_input_reports_lexical_error)
+{
+    std::istringstream stream{"boolean x\n/* never closed\nchar y\n"};
+
+    Token_reader reader{build_lexer(), Stream_source{stream, 4}, Location_mode::Lazy};
+
+    EXPECT_EQ(reader.lines(), nullptr);
+
+    ASSERT_TRUE(reader.next().has_value());
+    ASSERT_TRUE(reader.next().has_value());
+
+    EXPECT_FALSE(reader.next().has_value());
+
+    EXPECT_THROW((void) reader.tape(), std::logic_error);
+}
+
+TEST_F(Token_reader_test, Streamed_lexical_error_position_is_an_input_offset)
+{
+    const std::string input{"boolean x\nchar y\nstring @z\n"};
+
+    for (const std::size_t chunk_size : {4UL, 64UL})
+    {
+        std::istringstream stream{input};
+
+        Token_reader reader{build_lexer(), Stream_source{stream, chunk_size}};
+
+        for (;;)
+        {
+            const auto expected{reader.next()};
+
+            if (!expected)
+            {
+                EXPECT_EQ(expected.error().position(), input.find('@')) << "chunk size " << chunk_size;
+
+                break;
+            }
+
+            ASSERT_TRUE(expected.value().has_value()) << "chunk size " << chunk_size;
+        }
+    }
+}
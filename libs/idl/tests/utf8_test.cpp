@@ -0,0 +1,105 @@
+#include "parser/idl/utf8.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "parser/idl/lexer_factory.hpp"
+#include "parser/idl/line_index.hpp"
+#include "parser/idl/token_reader.hpp"
+
+using namespace parser::idl;
+
+namespace
+{
+std::vector<Isa> supported_isas()
+{
+    std::vector<Isa> isas;
+
+    for (const auto isa : {Isa::Scalar, Isa::Sse2, Isa::Avx2})
+    {
+        if (isa_supported(isa))
+        {
+            isas.push_back(isa);
+        }
+    }
+
+    return isas;
+}
+
+/**
+ * Column right after the first token spelled `lexeme`, read with the given location mode and column unit.
+ */
+std::size_t column_after(
+        const std::string& input, const std::string_view lexeme, const Location_mode mode, const Column_unit unit)
+{
+    Token_reader reader{Lexer_factory::build(), mode};
+
+    reader.set_column_unit(unit);
+
+    reader.load(input);
+
+    for (auto expected{reader.next()}; expected && *expected; expected = reader.next())
+    {
+        if (expected->value().lexeme() == lexeme)
+        {
+            return reader.location().column();
+        }
+    }
+
+    ADD_FAILURE() << "no token " << lexeme;
+
+    return 0;
+}
+
+} // namespace
+
+TEST(Utf8_test, Counts_code_points_and_utf16_units)
+{
+    // 'e' with acute accent (2 bytes), euro sign (3 bytes) and G clef (4 bytes, a surrogate pair in UTF-16).
+    const std::string sample{"a\xC3\xA9\xE2\x82\xAC\xF0\x9D\x84\x9E"};
+
+    std::string text;
+
+    for (std::size_t index{0}; index < 37; ++index)
+    {
+        text += sample;
+    }
+
+    for (const auto isa : supported_isas())
+    {
+        EXPECT_EQ(Utf8::code_points(text, isa), 4 * 37) << static_cast<int>(isa);
+        EXPECT_EQ(Utf8::utf16_units(text, isa), 5 * 37) << static_cast<int>(isa);
+        EXPECT_EQ(Utf8::length(text, Column_unit::Bytes, isa), text.size()) << static_cast<int>(isa);
+        EXPECT_FALSE(Utf8::ascii(text, isa)) << static_cast<int>(isa);
+        EXPECT_TRUE(Utf8::ascii(std::string(70, 'x'), isa)) << static_cast<int>(isa);
+    }
+}
+
+TEST(Utf8_test, Columns_count_the_chosen_unit)
+{
+    const std::string input{
+            "const string s = \"\xC3\xA9\xF0\x9D\x84\x9E\"; // \xE2\x82\xAC\n"
+            "x /* \xC3\xA9\n\xC3\xA9 */ y"};
+
+    for (const auto mode : {Location_mode::Eager, Location_mode::Lazy})
+    {
+        EXPECT_EQ(column_after(input, ";", mode, Column_unit::Bytes), 27);
+        EXPECT_EQ(column_after(input, ";", mode, Column_unit::Code_points), 23);
+        EXPECT_EQ(column_after(input, ";", mode, Column_unit::Utf16), 24);
+
+        EXPECT_EQ(column_after(input, "y", mode, Column_unit::Bytes), 8);
+        EXPECT_EQ(column_after(input, "y", mode, Column_unit::Code_points), 7);
+    }
+
+    const Line_index lines{input};
+
+    const auto offset{input.find(';')};
+
+    EXPECT_EQ(lines.column(offset), 26);
+    EXPECT_EQ(lines.column(offset, input, Column_unit::Code_points), 22);
+    EXPECT_EQ(lines.column(offset, input, Column_unit::Utf16), 23);
+}